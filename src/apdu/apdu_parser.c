@@ -45,10 +45,36 @@
  * Offset of command data.
  */
 #define OFFSET_CDATA 5
+/**
+ * Offset of command data of an extended length APDU, its Lc is 0x00 followed by 2 bytes.
+ */
+#define OFFSET_EXTENDED_CDATA 7
 
 bool apdu_parser(command_t *cmd, uint8_t *buf, size_t buf_len) {
-    // Check minimum length and Lc field of APDU command
-    if (buf_len < OFFSET_CDATA || buf_len - OFFSET_CDATA != buf[OFFSET_LC]) {
+    size_t offset_cdata = OFFSET_CDATA;
+    size_t lc;
+
+    // Check minimum length of APDU command
+    if (buf_len < OFFSET_CDATA) {
+        return false;
+    }
+
+    // A zero Lc starts an extended length if the command has data, the host only sends
+    // those when the transport accepts commands larger than 255 bytes of data
+    lc = buf[OFFSET_LC];
+    if (lc == 0 && buf_len > OFFSET_CDATA) {
+        if (buf_len < OFFSET_EXTENDED_CDATA) {
+            return false;
+        }
+        lc = (size_t) buf[OFFSET_LC + 1] << 8 | buf[OFFSET_LC + 2];
+        if (lc == 0) {
+            return false;
+        }
+        offset_cdata = OFFSET_EXTENDED_CDATA;
+    }
+
+    // Check Lc field of APDU command
+    if (buf_len - offset_cdata != lc) {
         return false;
     }
 
@@ -56,8 +82,8 @@ bool apdu_parser(command_t *cmd, uint8_t *buf, size_t buf_len) {
     cmd->ins = (command_e) buf[OFFSET_INS];
     cmd->p1 = buf[OFFSET_P1];
     cmd->p2 = buf[OFFSET_P2];
-    cmd->lc = buf[OFFSET_LC];
-    cmd->data = (buf[OFFSET_LC] > 0) ? buf + OFFSET_CDATA : NULL;
+    cmd->lc = lc;
+    cmd->data = (lc > 0) ? buf + offset_cdata : NULL;
 
     return true;
 }
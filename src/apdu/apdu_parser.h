@@ -9,6 +9,8 @@
 /**
  * Parse APDU command from byte buffer.
  *
+ * Both the short (1 byte) and extended (0x00 followed by 2 bytes) forms of Lc are accepted.
+ *
  * @param[out] cmd
  *   Structured APDU command (CLA, INS, P1, P2, Lc, Command data).
  * @param[in]  buf
@@ -49,6 +49,25 @@ int apdu_dispatcher(const command_t *cmd) {
             buf.size = cmd->lc;
             buf.offset = 0;
             return handler_get_public_key(&buf, (bool) cmd->p2);
+        case INS_GET_PUBLIC_KEYS:
+            if (cmd->p1 == P1_PUBLIC_KEYS) {
+                if (cmd->p2 != 0) {
+                    return io_send_sw(SW_WRONG_P1P2);
+                }
+                return handler_get_next_public_keys();
+            }
+            if (cmd->p1 != 0 || cmd->p2 != 0) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            if (!cmd->data) {
+                return io_send_sw(SW_WRONG_DATA_LENGTH);
+            }
+
+            buf.ptr = cmd->data;
+            buf.size = cmd->lc;
+            buf.offset = 0;
+            return handler_get_public_keys(&buf);
         case INS_SIGN_TX_HASH:
             if (cmd->p1 != 0 || cmd->p2 != 0) {
                 return io_send_sw(SW_WRONG_P1P2);
@@ -61,6 +80,27 @@ int apdu_dispatcher(const command_t *cmd) {
             buf.size = cmd->lc;
             buf.offset = 0;
             return handler_sign_tx_hash(&buf);
+        case INS_SIGN_TX_HASHES:
+            if (cmd->p1 == P1_SIGNATURES) {
+                if (cmd->p2 != 0) {
+                    return io_send_sw(SW_WRONG_P1P2);
+                }
+                return handler_send_tx_hashes_signatures();
+            }
+            if ((cmd->p1 != P1_FIRST && cmd->p1 != P1_MORE) ||
+                (cmd->p2 != P2_LAST && cmd->p2 != P2_MORE)) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            if (!cmd->data) {
+                return io_send_sw(SW_WRONG_DATA_LENGTH);
+            }
+
+            buf.ptr = cmd->data;
+            buf.size = cmd->lc;
+            buf.offset = 0;
+
+            return handler_sign_tx_hashes(&buf, !cmd->p1, (bool) (cmd->p2 & P2_MORE));
         case INS_SIGN_TX:
             if ((cmd->p1 != P1_FIRST && cmd->p1 != P1_MORE) ||
                 (cmd->p2 != P2_LAST && cmd->p2 != P2_MORE)) {
@@ -76,6 +116,58 @@ int apdu_dispatcher(const command_t *cmd) {
             buf.offset = 0;
 
             return handler_sign_tx(&buf, !cmd->p1, (bool) (cmd->p2 & P2_MORE));
+        case INS_SIGN_TX_SIGNERS:
+            if (cmd->p1 == P1_SIGNATURES) {
+                if (cmd->p2 != 0) {
+                    return io_send_sw(SW_WRONG_P1P2);
+                }
+                return handler_send_tx_signers_signatures();
+            }
+            if ((cmd->p1 != P1_FIRST && cmd->p1 != P1_MORE) ||
+                (cmd->p2 != P2_LAST && cmd->p2 != P2_MORE)) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            if (!cmd->data) {
+                return io_send_sw(SW_WRONG_DATA_LENGTH);
+            }
+
+            buf.ptr = cmd->data;
+            buf.size = cmd->lc;
+            buf.offset = 0;
+
+            return handler_sign_tx_signers(&buf, !cmd->p1, (bool) (cmd->p2 & P2_MORE));
+        case INS_SIGN_TX_BATCH:
+            if (cmd->p1 == P1_SIGNATURES) {
+                if (cmd->p2 != 0) {
+                    return io_send_sw(SW_WRONG_P1P2);
+                }
+                return handler_send_tx_batch_signatures();
+            }
+            if ((cmd->p1 != P1_FIRST && cmd->p1 != P1_MORE) ||
+                (cmd->p2 != P2_LAST && cmd->p2 != P2_MORE && cmd->p2 != P2_MORE_ENVELOPES)) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+
+            if (!cmd->data) {
+                return io_send_sw(SW_WRONG_DATA_LENGTH);
+            }
+
+            buf.ptr = cmd->data;
+            buf.size = cmd->lc;
+            buf.offset = 0;
+
+            return handler_sign_tx_batch(&buf,
+                                         !cmd->p1,
+                                         cmd->p2 == P2_MORE,
+                                         cmd->p2 == P2_MORE_ENVELOPES);
+#ifdef HAVE_STATS
+        case INS_GET_STATS:
+            if (cmd->p1 > P1_RESET_STATS || cmd->p2 != 0) {
+                return io_send_sw(SW_WRONG_P1P2);
+            }
+            return handler_get_stats((bool) cmd->p1);
+#endif
         default:
             return io_send_sw(SW_INS_NOT_SUPPORTED);
     }
@@ -10,6 +10,10 @@
  * Parameter 2 for more APDU to receive.
  */
 #define P2_MORE 0x80
+/**
+ * Parameter 2 for the last APDU of an envelope, more envelopes of the batch to receive.
+ */
+#define P2_MORE_ENVELOPES 0x40
 /**
  * Parameter 1 for first APDU number.
  */
@@ -18,6 +22,18 @@
  * Parameter 1 for more APDU to receive.
  */
 #define P1_MORE 0x80
+/**
+ * Parameter 1 to request the next signatures of a batch or of the signers of a transaction.
+ */
+#define P1_SIGNATURES 0x01
+/**
+ * Parameter 1 to request the next public keys of a range.
+ */
+#define P1_PUBLIC_KEYS 0x01
+/**
+ * Parameter 1 to reset the performance counters once sent.
+ */
+#define P1_RESET_STATS 0x01
 
 /**
  * Dispatch APDU command received to the right handler.
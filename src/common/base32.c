@@ -92,3 +92,44 @@ int base32_encode(const uint8_t *data, int length, uint8_t *result, int buf_size
     }
     return count;
 }
+
+static const uint8_t BASE32_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+
+// Encode one 5-byte block into 8 digits, byte-wise so that it stays cheap without 64-bit shifts
+static void base32_encode_block(const uint8_t *in, uint8_t *out) {
+    out[0] = BASE32_ALPHABET[in[0] >> 3];
+    out[1] = BASE32_ALPHABET[((in[0] & 0x07) << 2) | (in[1] >> 6)];
+    out[2] = BASE32_ALPHABET[(in[1] >> 1) & 0x1F];
+    out[3] = BASE32_ALPHABET[((in[1] & 0x01) << 4) | (in[2] >> 4)];
+    out[4] = BASE32_ALPHABET[((in[2] & 0x0F) << 1) | (in[3] >> 7)];
+    out[5] = BASE32_ALPHABET[(in[3] >> 2) & 0x1F];
+    out[6] = BASE32_ALPHABET[((in[3] & 0x03) << 3) | (in[4] >> 5)];
+    out[7] = BASE32_ALPHABET[in[4] & 0x1F];
+}
+
+int base32_encode_blocks(const uint8_t *data, int length, uint8_t *result, int buf_size) {
+    if (length < 0 || length > (1 << 28)) {
+        return -1;
+    }
+    int count = (length * 8 + 4) / 5;
+    if (count > buf_size) {
+        return -1;
+    }
+    int blocks = length / 5;
+    for (int i = 0; i < blocks; i++) {
+        base32_encode_block(data + 5 * i, result + 8 * i);
+    }
+    int tail = length - 5 * blocks;
+    if (tail > 0) {
+        // zero padded last block, only the digits holding data bits are kept
+        uint8_t in[5] = {0};
+        uint8_t out[8];
+        memcpy(in, data + 5 * blocks, tail);
+        base32_encode_block(in, out);
+        memcpy(result + 8 * blocks, out, count - 8 * blocks);
+    }
+    if (count < buf_size) {
+        result[count] = '\000';
+    }
+    return count;
+}
@@ -31,3 +31,8 @@
 int base32_decode(const uint8_t *encoded, uint8_t *result, int buf_size);
 
 int base32_encode(const uint8_t *data, int length, uint8_t *result, int buf_size);
+
+// Same output as base32_encode, 5 bytes into 8 digits at a time, for the StrKey encodings
+// displayed on most review screens. Returns -1 instead of truncating if the output buffer is too
+// small.
+int base32_encode_blocks(const uint8_t *data, int length, uint8_t *result, int buf_size);
@@ -60,38 +60,52 @@ bool format_i64(char *dst, size_t dst_len, const int64_t value) {
     return true;
 }
 
-bool format_u64(char *out, size_t outLen, uint64_t in) {
-    uint8_t i = 0;
-
-    if (outLen == 0) {
-        return false;
+static const char DIGIT_PAIRS[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const uint32_t POWERS_OF_TEN[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+void format_u32_digits(char *dst, uint32_t value, uint8_t digits) {
+    while (digits >= 2) {
+        digits -= 2;
+        uint32_t q = value / 100;
+        memcpy(dst + digits, &DIGIT_PAIRS[2 * (value - q * 100)], 2);
+        value = q;
     }
-    outLen--;
-
-    while (in > 9) {
-        out[i] = in % 10 + '0';
-        in /= 10;
-        i++;
-        if (i + 1 > outLen) {
-            return false;
-        }
+    if (digits == 1) {
+        dst[0] = '0' + value;
     }
-    out[i] = in + '0';
-    out[i + 1] = '\0';
-
-    uint8_t j = 0;
-    char tmp;
+}
 
-    // revert the string
-    while (j < i) {
-        // swap out[j] and out[i]
-        tmp = out[j];
-        out[j] = out[i];
-        out[i] = tmp;
+bool format_u64(char *out, size_t outLen, uint64_t in) {
+    // split in parts below 10^9 so that the digits are computed with 32-bit arithmetic only
+    uint32_t parts[2];
+    uint8_t parts_count = 0;
+    while (in >= 1000000000 && parts_count < 2) {
+        uint64_t q = in / 1000000000;
+        parts[parts_count++] = in - q * 1000000000;
+        in = q;
+    }
+    uint32_t top = in;  // < 19 once two parts are split
+    uint8_t top_digits = 1;
+    while (top_digits < 10 && top >= POWERS_OF_TEN[top_digits]) {
+        top_digits++;
+    }
 
-        i--;
-        j++;
+    size_t len = top_digits + 9 * parts_count;
+    if (outLen < len + 1) {
+        return false;
+    }
+    format_u32_digits(out, top, top_digits);
+    for (uint8_t i = 0; i < parts_count; i++) {
+        format_u32_digits(out + top_digits + 9 * i, parts[parts_count - 1 - i], 9);
     }
+    out[len] = '\0';
     return true;
 }
 
@@ -19,6 +19,20 @@
  */
 bool format_i64(char *dst, size_t dst_len, const int64_t value);
 
+/**
+ * Format 32-bit unsigned integer as exactly `digits` decimal digits, zero padded and without
+ * terminator. Digits are written two at a time from a lookup table.
+ *
+ * @param[out] dst
+ *   Pointer to output buffer, at least `digits` long.
+ * @param[in]  value
+ *   32-bit unsigned integer to format, lower than 10^digits.
+ * @param[in]  digits
+ *   Number of digits to write.
+ *
+ */
+void format_u32_digits(char *dst, uint32_t value, uint8_t digits);
+
 /**
  * Format 64-bit unsigned integer as string.
  *
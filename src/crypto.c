@@ -15,19 +15,37 @@
  *  limitations under the License.
  *****************************************************************************/
 
-#include <stdint.h>  // uint*_t
-#include <string.h>  // explicit_bzero
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <string.h>   // explicit_bzero, memcmp
 
 #include "./crypto.h"
 #include "./globals.h"
+#include "./stats.h"
 
 #define STELLAR_SEED_KEY "ed25519 seed"
 
+#ifdef HAVE_PUBLIC_KEY_CACHE
+/* Number of public keys kept for the session */
+#define PUBLIC_KEY_CACHE_SIZE 4
+
+typedef struct {
+    uint32_t bip32_path[MAX_BIP32_PATH];
+    uint8_t bip32_path_len;
+    bool used;
+    uint8_t raw_public_key[RAW_ED25519_PUBLIC_KEY_SIZE];
+} public_key_cache_entry_t;
+
+static public_key_cache_entry_t public_key_cache[PUBLIC_KEY_CACHE_SIZE];
+static uint8_t public_key_cache_next;  // entry replaced on the next miss
+#endif
+
 int crypto_derive_private_key(cx_ecfp_private_key_t *private_key,
                               const uint32_t *bip32_path,
                               uint8_t bip32_path_len) {
     uint8_t raw_private_key[RAW_ED25519_PRIVATE_KEY_SIZE] = {0};
 
+    STATS_INC(STATS_KEY_DERIVATIONS);
     BEGIN_TRY {
         TRY {
             // derive the seed with bip32_path
@@ -79,19 +97,71 @@ int crypto_init_public_key(cx_ecfp_private_key_t *private_key,
     return 0;
 }
 
+int crypto_get_public_key(const uint32_t *bip32_path,
+                          uint8_t bip32_path_len,
+                          uint8_t raw_public_key[static RAW_ED25519_PUBLIC_KEY_SIZE]) {
+#ifdef HAVE_PUBLIC_KEY_CACHE
+    for (uint8_t i = 0; i < PUBLIC_KEY_CACHE_SIZE; i++) {
+        public_key_cache_entry_t *entry = &public_key_cache[i];
+        if (entry->used && entry->bip32_path_len == bip32_path_len &&
+            memcmp(entry->bip32_path, bip32_path, bip32_path_len * sizeof(uint32_t)) == 0) {
+            memcpy(raw_public_key, entry->raw_public_key, RAW_ED25519_PUBLIC_KEY_SIZE);
+            return 0;
+        }
+    }
+#endif
+
+    cx_ecfp_private_key_t private_key = {0};
+    cx_ecfp_public_key_t public_key = {0};
+
+    // derive private key according to BIP32 path
+    crypto_derive_private_key(&private_key, bip32_path, bip32_path_len);
+    // generate corresponding public key
+    crypto_init_public_key(&private_key, &public_key, raw_public_key);
+    // reset private key
+    explicit_bzero(&private_key, sizeof(private_key));
+
+#ifdef HAVE_PUBLIC_KEY_CACHE
+    public_key_cache_entry_t *entry = &public_key_cache[public_key_cache_next];
+    memcpy(entry->bip32_path, bip32_path, bip32_path_len * sizeof(uint32_t));
+    entry->bip32_path_len = bip32_path_len;
+    memcpy(entry->raw_public_key, raw_public_key, RAW_ED25519_PUBLIC_KEY_SIZE);
+    entry->used = true;
+    public_key_cache_next = (public_key_cache_next + 1) % PUBLIC_KEY_CACHE_SIZE;
+#endif
+    return 0;
+}
+
 int crypto_sign_message(const uint8_t *message,
                         uint8_t message_len,
                         const uint8_t *signature,
                         uint8_t signature_len) {
     cx_ecfp_private_key_t private_key = {0};
-    int sig_len = 0;
+    int ret;
 
     // derive private key according to BIP32 path
     crypto_derive_private_key(&private_key, G_context.bip32_path, G_context.bip32_path_len);
 
+    ret = crypto_sign_message_with_key(&private_key,
+                                       message,
+                                       message_len,
+                                       signature,
+                                       signature_len);
+    explicit_bzero(&private_key, sizeof(private_key));
+    return ret;
+}
+
+int crypto_sign_message_with_key(cx_ecfp_private_key_t *private_key,
+                                 const uint8_t *message,
+                                 uint8_t message_len,
+                                 const uint8_t *signature,
+                                 uint8_t signature_len) {
+    int sig_len = 0;
+
+    STATS_INC(STATS_SIGNATURES);
     BEGIN_TRY {
         TRY {
-            sig_len = cx_eddsa_sign(&private_key,
+            sig_len = cx_eddsa_sign(private_key,
                                     CX_LAST,
                                     CX_SHA512,
                                     message,
@@ -104,10 +174,10 @@ int crypto_sign_message(const uint8_t *message,
             PRINTF("Signature: %.*H\n", sig_len, signature);
         }
         CATCH_OTHER(e) {
+            explicit_bzero(private_key, sizeof(*private_key));
             THROW(e);
         }
         FINALLY {
-            explicit_bzero(&private_key, sizeof(private_key));
         }
     }
     END_TRY;
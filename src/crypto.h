@@ -44,6 +44,28 @@ int crypto_init_public_key(cx_ecfp_private_key_t *private_key,
                            cx_ecfp_public_key_t *public_key,
                            uint8_t raw_public_key[static RAW_ED25519_PUBLIC_KEY_SIZE]);
 
+/**
+ * Get the raw public key of a BIP32 path.
+ *
+ * With HAVE_PUBLIC_KEY_CACHE the public keys of the last paths are kept for the session, the
+ * private key is only derived for a path missing from the cache and never kept.
+ *
+ * @param[in]  bip32_path
+ *   Pointer to buffer with BIP32 path.
+ * @param[in]  bip32_path_len
+ *   Number of path in BIP32 path.
+ * @param[out] raw_public_key
+ *   Pointer to raw public key.
+ *
+ * @return 0 if success, -1 otherwise.
+ *
+ * @throw INVALID_PARAMETER
+ *
+ */
+int crypto_get_public_key(const uint32_t *bip32_path,
+                          uint8_t bip32_path_len,
+                          uint8_t raw_public_key[static RAW_ED25519_PUBLIC_KEY_SIZE]);
+
 /**
  * Sign message.
  *
@@ -56,3 +78,17 @@ int crypto_sign_message(const uint8_t *message,
                         uint8_t message_len,
                         const uint8_t *signature,
                         uint8_t signature_len);
+
+/**
+ * Sign message with an already derived private key, which is wiped if signing throws.
+ *
+ * @return 0 if success, -1 otherwise.
+ *
+ * @throw INVALID_PARAMETER
+ *
+ */
+int crypto_sign_message_with_key(cx_ecfp_private_key_t *private_key,
+                                 const uint8_t *message,
+                                 uint8_t message_len,
+                                 const uint8_t *signature,
+                                 uint8_t signature_len);
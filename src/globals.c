@@ -1,4 +1,5 @@
 #include "./globals.h"
+#include "./stats.h"
 
 uint8_t G_io_seproxyhal_spi_buffer[IO_SEPROXYHAL_BUFFER_SIZE_B];
 ux_state_t G_ux;
@@ -16,3 +17,7 @@ char G_ui_detail_value[DETAIL_VALUE_MAX_LENGTH];
 volatile uint8_t G_ui_current_state;
 uint8_t G_ui_current_data_index;
 ui_action_validate_cb G_ui_validate_callback;
+
+#ifdef HAVE_STATS
+uint32_t G_stats[STATS_COUNTERS_COUNT];
+#endif
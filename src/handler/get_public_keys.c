@@ -0,0 +1,68 @@
+/*****************************************************************************
+ *   Ledger Stellar App.
+ *   (c) 2022 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdint.h>  // uint*_t
+#include <string.h>  // explicit_bzero
+
+#include "./handler.h"
+#include "../globals.h"
+#include "../types.h"
+#include "../io.h"
+#include "../sw.h"
+#include "../send_response.h"
+#include "../common/buffer.h"
+
+int handler_get_public_keys(buffer_t *cdata) {
+    PRINTF("handler_get_public_keys invoked\n");
+
+    explicit_bzero(&G_context, sizeof(G_context));
+    G_context.req_type = EXPORT_PUBLIC_KEYS;
+    G_context.state = STATE_NONE;
+
+    uint32_t first_index;
+    uint8_t count;
+
+    if (!buffer_read_u8(cdata, &G_context.bip32_path_len) ||
+        G_context.bip32_path_len >= MAX_BIP32_PATH ||
+        !buffer_read_bip32_path(cdata, G_context.bip32_path, (size_t) G_context.bip32_path_len) ||
+        !buffer_read_u32(cdata, &first_index, BE) || !buffer_read_u8(cdata, &count) ||
+        cdata->offset != cdata->size) {
+        return io_send_sw(SW_WRONG_DATA_LENGTH);
+    }
+    // the range must not wrap around, nor run from unhardened indexes into hardened ones
+    if (count == 0 || first_index > UINT32_MAX - (count - 1) ||
+        (first_index & 0x80000000u) != ((first_index + (count - 1)) & 0x80000000u)) {
+        return io_send_sw(SW_WRONG_DATA_LENGTH);
+    }
+
+    // room for the index, set for each public key of the range
+    G_context.bip32_path_len++;
+    G_context.public_keys_index = first_index;
+    G_context.public_keys_count = count;
+
+    return send_response_pubkeys();
+}
+
+int handler_get_next_public_keys() {
+    PRINTF("handler_get_next_public_keys invoked\n");
+
+    if (G_context.req_type != EXPORT_PUBLIC_KEYS || G_context.public_keys_count == 0) {
+        return io_send_sw(SW_BAD_STATE);
+    }
+
+    return send_response_pubkeys();
+}
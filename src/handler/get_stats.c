@@ -0,0 +1,46 @@
+/*****************************************************************************
+ *   Ledger Stellar App.
+ *   (c) 2022 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#ifdef HAVE_STATS
+
+#include <stdint.h>   // uint*_t
+#include <stdbool.h>  // bool
+#include <string.h>   // explicit_bzero
+
+#include "./handler.h"
+#include "../io.h"
+#include "../sw.h"
+#include "../stats.h"
+#include "../common/buffer.h"
+#include "../common/write.h"
+
+int handler_get_stats(bool reset) {
+    PRINTF("handler_get_stats invoked\n");
+
+    uint8_t resp[STATS_COUNTERS_COUNT * 4];
+    for (uint8_t i = 0; i < STATS_COUNTERS_COUNT; i++) {
+        write_u32_be(resp, i * 4, G_stats[i]);
+    }
+    if (reset) {
+        explicit_bzero(G_stats, sizeof(G_stats));
+    }
+
+    return io_send_response(&(const buffer_t){.ptr = resp, .size = sizeof(resp), .offset = 0},
+                            SW_OK);
+}
+
+#endif  // HAVE_STATS
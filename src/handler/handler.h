@@ -28,6 +28,27 @@ int handler_get_app_configuration(void);
  */
 int handler_get_public_key(buffer_t *cdata, bool display);
 
+/**
+ * Handler for INS_GET_PUBLIC_KEYS command. If successfully parse the base BIP32 path and
+ * the range of indexes appended to it, send APDU response with the first public keys.
+ *
+ * @param[in,out] cdata
+ *   Command data with base BIP32 path, first index and number of indexes.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_get_public_keys(buffer_t *cdata);
+
+/**
+ * Handler for INS_GET_PUBLIC_KEYS command with P1_PUBLIC_KEYS. Send the next public keys
+ * of the range.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_get_next_public_keys(void);
+
 /**
  * Handler for INS_SIGN_TX command. If successfully parse BIP32 path
  * and transaction, sign transaction and send APDU response.
@@ -44,6 +65,31 @@ int handler_get_public_key(buffer_t *cdata, bool display);
  */
 int handler_sign_tx(buffer_t *cdata, bool is_first_chunk, bool more);
 
+/**
+ * Handler for INS_SIGN_TX_SIGNERS command. Receive the BIP32 paths of the signers and the
+ * raw transaction, then start a single review for all the signers.
+ *
+ * @param[in,out] cdata
+ *   Command data with BIP32 paths (first chunk only) and raw transaction serialized.
+ * @param[in]     is_first_chunk
+ *   Is the first data chunk
+ * @param[in]     more
+ *   Whether more APDU chunk to be received or not.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_sign_tx_signers(buffer_t *cdata, bool is_first_chunk, bool more);
+
+/**
+ * Handler for INS_SIGN_TX_SIGNERS command with P1_SIGNATURES. Send the next signatures of
+ * an approved transaction.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_send_tx_signers_signatures(void);
+
 /**
  * Handler for INS_SIGN_TX_HASH command. If successfully parse BIP32 path
  * and transaction hash, sign transaction hash and send APDU response.
@@ -55,3 +101,70 @@ int handler_sign_tx(buffer_t *cdata, bool is_first_chunk, bool more);
  *
  */
 int handler_sign_tx_hash(buffer_t *cdata);
+
+/**
+ * Handler for INS_SIGN_TX_HASHES command. Receive the BIP32 path and a batch of
+ * transaction hashes, then start a single review of the whole batch.
+ *
+ * @param[in,out] cdata
+ *   Command data with BIP32 path (first chunk only) and transaction hashes.
+ * @param[in]     is_first_chunk
+ *   Is the first data chunk
+ * @param[in]     more
+ *   Whether more APDU chunk to be received or not.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_sign_tx_hashes(buffer_t *cdata, bool is_first_chunk, bool more);
+
+/**
+ * Handler for INS_SIGN_TX_HASHES command with P1_SIGNATURES. Send the next signatures of
+ * an approved batch of transaction hashes.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_send_tx_hashes_signatures(void);
+
+/**
+ * Handler for INS_SIGN_TX_BATCH command. Receive the BIP32 path and the envelopes of a
+ * batch one after the other, keeping only their hashes and summaries, then start a single
+ * review of the whole batch.
+ *
+ * @param[in,out] cdata
+ *   Command data with BIP32 path (first chunk only) and raw transaction serialized.
+ * @param[in]     is_first_chunk
+ *   Is the first data chunk of the batch
+ * @param[in]     more
+ *   Whether more APDU chunk of the envelope to be received or not.
+ * @param[in]     more_envelopes
+ *   Whether more envelopes to be received after this one or not.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_sign_tx_batch(buffer_t *cdata, bool is_first_chunk, bool more, bool more_envelopes);
+
+/**
+ * Handler for INS_SIGN_TX_BATCH command with P1_SIGNATURES. Send the next signatures of an
+ * approved batch of transactions.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_send_tx_batch_signatures(void);
+
+#ifdef HAVE_STATS
+/**
+ * Handler for INS_GET_STATS command, debug builds only. Send APDU response with the
+ * performance counters.
+ *
+ * @param[in] reset
+ *   Whether to reset the counters once sent.
+ *
+ * @return zero or positive integer if success, negative integer otherwise.
+ *
+ */
+int handler_get_stats(bool reset);
+#endif
@@ -19,12 +19,49 @@
 #include "../globals.h"
 #include "../types.h"
 #include "../sw.h"
+#include "../stats.h"
 #include "../send_response.h"
 #include "../crypto.h"
 #include "../ui/ui.h"
 #include "../swap/swap_lib_calls.h"
 #include "../transaction/transaction_parser.h"
 
+// Hash and parse a chunk of the envelope, true once the last one is received and validated
+static bool receive_tx_chunk(buffer_t *cdata, bool more) {
+    // hash and parse each chunk as it arrives, so that the last one only has its own
+    // bytes left to process
+    uint8_t *chunk = G_context.tx_info.raw + G_context.tx_info.raw_size;
+    size_t chunk_length = cdata->size - cdata->offset;
+    memcpy(chunk, cdata->ptr + cdata->offset, chunk_length);
+    G_context.tx_info.raw_size += chunk_length;
+    STATS_ADD(STATS_HASHED_BYTES, chunk_length);
+    cx_hash(&G_context.hash_ctx.header, 0, chunk, chunk_length, NULL, 0);
+    parse_tx_xdr_prefix(G_context.tx_info.raw, G_context.tx_info.raw_size, &G_context.tx_info);
+
+    PRINTF("data size: %d\n", G_context.tx_info.raw_size);
+
+    if (more) {
+        return false;
+    }
+
+    // the hash is final, no more chunks are accepted even if the envelope is rejected
+    G_context.state = STATE_NONE;
+    if (cx_hash(&G_context.hash_ctx.header, CX_LAST, NULL, 0, G_context.hash, HASH_SIZE) !=
+        HASH_SIZE) {
+        THROW(SW_TX_HASH_FAIL);
+    }
+
+    // reject malformed envelopes before the review starts, this also indexes the operation
+    // offsets so that paging back through the review only parses the operation displayed
+    if (!validate_tx_xdr(G_context.tx_info.raw, G_context.tx_info.raw_size, &G_context.tx_info)) {
+        THROW(SW_TX_PARSING_FAIL);
+    }
+
+    G_context.state = STATE_PARSED;
+    PRINTF("tx parsed.\n");
+    return true;
+}
+
 int handler_sign_tx(buffer_t *cdata, bool is_first_chunk, bool more) {
     if (is_first_chunk) {
         explicit_bzero(&G_context, sizeof(G_context));
@@ -35,46 +72,25 @@ int handler_sign_tx(buffer_t *cdata, bool is_first_chunk, bool more) {
     }
 
     if (is_first_chunk) {
-        G_context.req_type = CONFIRM_TRANSACTION;
-        G_context.state = STATE_NONE;
-
         if (!buffer_read_u8(cdata, &G_context.bip32_path_len) ||
             !buffer_read_bip32_path(cdata,
                                     G_context.bip32_path,
                                     (size_t) G_context.bip32_path_len)) {
             return io_send_sw(SW_WRONG_DATA_LENGTH);
         }
-        size_t data_length = cdata->size - cdata->offset;
-        memcpy(G_context.tx_info.raw, cdata->ptr + cdata->offset, data_length);
-        G_context.tx_info.raw_size += data_length;
-    } else {
-        if (G_context.req_type != CONFIRM_TRANSACTION) {
-            return io_send_sw(SW_BAD_STATE);
-        }
-        memcpy(G_context.tx_info.raw + G_context.tx_info.raw_size, cdata->ptr, cdata->size);
-        G_context.tx_info.raw_size += cdata->size;
+        cx_sha256_init(&G_context.hash_ctx);
+        // the next chunks are only accepted once the hash of the first one is started
+        G_context.req_type = CONFIRM_TRANSACTION;
+        G_context.state = STATE_RECEIVING;
+    } else if (G_context.req_type != CONFIRM_TRANSACTION ||
+               G_context.state != STATE_RECEIVING) {
+        return io_send_sw(SW_BAD_STATE);
     }
 
-    PRINTF("data size: %d\n", G_context.tx_info.raw_size);
-
-    if (more) {
+    if (!receive_tx_chunk(cdata, more)) {
         return io_send_sw(SW_OK);
     }
 
-    if (cx_hash_sha256(G_context.tx_info.raw,
-                       G_context.tx_info.raw_size,
-                       G_context.hash,
-                       HASH_SIZE) != HASH_SIZE) {
-        THROW(SW_TX_HASH_FAIL);
-    }
-
-    if (!parse_tx_xdr(G_context.tx_info.raw, G_context.tx_info.raw_size, &G_context.tx_info)) {
-        THROW(SW_TX_PARSING_FAIL);
-    }
-
-    G_context.state = STATE_PARSED;
-    PRINTF("tx parsed.\n");
-
     if (G_called_from_swap) {
         if (!swap_check()) {
             return io_send_sw(SW_SWAP_CHECKING_FAIL);
@@ -89,15 +105,59 @@ int handler_sign_tx(buffer_t *cdata, bool is_first_chunk, bool more) {
         }
     }
 
-    cx_ecfp_private_key_t private_key = {0};
-    cx_ecfp_public_key_t public_key = {0};
-
-    // derive private key according to BIP32 path
-    crypto_derive_private_key(&private_key, G_context.bip32_path, G_context.bip32_path_len);
-    // generate corresponding public key
-    crypto_init_public_key(&private_key, &public_key, G_context.raw_public_key);
-    // reset private key
-    explicit_bzero(&private_key, sizeof(private_key));
+    crypto_get_public_key(G_context.bip32_path, G_context.bip32_path_len, G_context.raw_public_key);
 
     return ui_approve_tx_init();
 };
+
+int handler_sign_tx_signers(buffer_t *cdata, bool is_first_chunk, bool more) {
+    if (is_first_chunk) {
+        explicit_bzero(&G_context, sizeof(G_context));
+    }
+
+    if (G_context.tx_info.raw_size + cdata->size > RAW_TX_MAX_SIZE) {
+        return io_send_sw(SW_WRONG_TX_LENGTH);
+    }
+
+    if (is_first_chunk) {
+        if (!buffer_read_u8(cdata, &G_context.signers_count) || G_context.signers_count == 0 ||
+            G_context.signers_count > SIGNERS_MAX_COUNT) {
+            return io_send_sw(SW_WRONG_DATA_LENGTH);
+        }
+        for (uint8_t i = 0; i < G_context.signers_count; i++) {
+            signing_path_t *signer = &G_context.signers[i];
+            if (!buffer_read_u8(cdata, &signer->bip32_path_len) ||
+                !buffer_read_bip32_path(cdata,
+                                        signer->bip32_path,
+                                        (size_t) signer->bip32_path_len)) {
+                return io_send_sw(SW_WRONG_DATA_LENGTH);
+            }
+        }
+        cx_sha256_init(&G_context.hash_ctx);
+        G_context.req_type = CONFIRM_TRANSACTION_SIGNERS;
+        G_context.state = STATE_RECEIVING;
+    } else if (G_context.req_type != CONFIRM_TRANSACTION_SIGNERS ||
+               G_context.state != STATE_RECEIVING) {
+        return io_send_sw(SW_BAD_STATE);
+    }
+
+    if (!receive_tx_chunk(cdata, more)) {
+        return io_send_sw(SW_OK);
+    }
+
+    // the review shows the account of each signer and compares them with the transaction's
+    for (uint8_t i = 0; i < G_context.signers_count; i++) {
+        signing_path_t *signer = &G_context.signers[i];
+        crypto_get_public_key(signer->bip32_path, signer->bip32_path_len, signer->raw_public_key);
+    }
+
+    return ui_approve_tx_init();
+}
+
+int handler_send_tx_signers_signatures() {
+    PRINTF("handler_send_tx_signers_signatures invoked\n");
+    if (G_context.req_type != CONFIRM_TRANSACTION_SIGNERS || G_context.state != STATE_APPROVED) {
+        return io_send_sw(SW_BAD_STATE);
+    }
+    return send_response_signers_sigs();
+}
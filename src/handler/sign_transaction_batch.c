@@ -0,0 +1,223 @@
+/*****************************************************************************
+ *   Ledger Stellar App.
+ *   (c) 2022 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <string.h>  // memcpy, memcmp, explicit_bzero
+
+#include "./handler.h"
+#include "../globals.h"
+#include "../sw.h"
+#include "../stats.h"
+#include "../crypto.h"
+#include "../io.h"
+#include "../send_response.h"
+#include "../ui/ui.h"
+#include "../transaction/transaction_parser.h"
+
+static void copy_account(const muxed_account_t *account, batch_account_t *out) {
+    explicit_bzero(out, sizeof(*out));
+    out->type = account->type;
+    if (account->type == KEY_TYPE_MUXED_ED25519) {
+        out->id = account->med25519.id;
+        memcpy(out->key, account->med25519.ed25519, RAW_ED25519_PUBLIC_KEY_SIZE);
+    } else {
+        memcpy(out->key, account->ed25519, RAW_ED25519_PUBLIC_KEY_SIZE);
+    }
+}
+
+static bool same_account(const batch_account_t *a, const batch_account_t *b) {
+    return a->type == b->type && a->id == b->id &&
+           memcmp(a->key, b->key, RAW_ED25519_PUBLIC_KEY_SIZE) == 0;
+}
+
+// Index of the asset in the totals of the batch, added if new, -1 if there is no room left
+static int find_asset(batch_t *batch, const asset_t *asset) {
+    batch_asset_t entry = {.type = asset->type};
+
+    if (asset->type == ASSET_TYPE_CREDIT_ALPHANUM4) {
+        memcpy(entry.code, asset->alpha_num4.asset_code, 4);
+        memcpy(entry.issuer, asset->alpha_num4.issuer, RAW_ED25519_PUBLIC_KEY_SIZE);
+    } else if (asset->type == ASSET_TYPE_CREDIT_ALPHANUM12) {
+        memcpy(entry.code, asset->alpha_num12.asset_code, 12);
+        memcpy(entry.issuer, asset->alpha_num12.issuer, RAW_ED25519_PUBLIC_KEY_SIZE);
+    }
+    for (uint8_t i = 0; i < batch->assets_count; i++) {
+        const batch_asset_t *known = &batch->assets[i];
+        if (known->type == entry.type && memcmp(known->code, entry.code, sizeof(entry.code)) == 0 &&
+            memcmp(known->issuer, entry.issuer, sizeof(entry.issuer)) == 0) {
+            return i;
+        }
+    }
+    if (batch->assets_count == BATCH_ASSETS_MAX_COUNT) {
+        return -1;
+    }
+    batch->assets[batch->assets_count] = entry;
+    return batch->assets_count++;
+}
+
+// Whether the validity conditions are at most an upper time bound, which the review shows
+static bool has_simple_conditions(const preconditions_t *cond) {
+    return !cond->ledger_bounds_present && !cond->min_seq_num_present && cond->min_seq_age == 0 &&
+           cond->min_seq_ledger_gap == 0 &&
+           (!cond->time_bounds_present || cond->time_bounds.min_time == 0);
+}
+
+// Summarize the envelope just validated, false if the batch review can't show all it does
+static bool add_to_batch(void) {
+    tx_ctx_t *tx_ctx = &G_context.tx_info;
+    transaction_details_t *tx_details = &tx_ctx->tx_details;
+    batch_t *batch = &tx_ctx->batch;
+    batch_envelope_t *envelope = &batch->envelopes[G_context.hashes_count];
+    batch_account_t source;
+
+    // the review shows the network and the source once for the whole batch, and one screen of
+    // each envelope: a memo, validity conditions or more operations would go unseen
+    if (tx_ctx->envelope_type != ENVELOPE_TYPE_TX || tx_details->operations_count != 1 ||
+        tx_details->memo.type != MEMO_NONE || !has_simple_conditions(&tx_details->cond)) {
+        return false;
+    }
+    copy_account(&tx_ctx->tx_details.source_account, &source);
+    if (G_context.hashes_count == 0) {
+        batch->network = tx_ctx->network;
+        batch->source = source;
+    } else if (tx_ctx->network != batch->network || !same_account(&source, &batch->source)) {
+        return false;
+    }
+
+    envelope->fee = tx_details->fee;
+    envelope->max_time = tx_details->cond.time_bounds_present ? tx_details->cond.time_bounds.max_time
+                                                              : 0;
+    batch->fees += envelope->fee;
+
+    // only payments from the source are summed up, any other operation needs its own review
+    if (!parse_tx_xdr_operation(tx_ctx->raw, tx_ctx->raw_size, tx_ctx, 0)) {
+        return false;
+    }
+    const operation_t *op = &tx_details->op_details;
+    asset_t asset = {.type = ASSET_TYPE_NATIVE};
+    int64_t amount;
+
+    if (op->source_account_present) {
+        batch_account_t op_source;
+        copy_account(&op->source_account, &op_source);
+        if (!same_account(&op_source, &source)) {
+            return false;
+        }
+    }
+    switch (op->type) {
+        case OPERATION_TYPE_PAYMENT:
+            copy_account(&op->payment_op.destination, &envelope->destination);
+            asset = op->payment_op.asset;
+            amount = op->payment_op.amount;
+            break;
+        case OPERATION_TYPE_CREATE_ACCOUNT:
+            copy_account(&(const muxed_account_t){.type = KEY_TYPE_ED25519,
+                                                  .ed25519 = op->create_account_op.destination},
+                         &envelope->destination);
+            amount = op->create_account_op.starting_balance;
+            break;
+        default:
+            return false;
+    }
+
+    int index = find_asset(batch, &asset);
+    if (index < 0 || amount < 0 || batch->assets[index].total + amount < (uint64_t) amount) {
+        return false;
+    }
+    batch->assets[index].total += amount;
+    envelope->asset_index = index;
+    envelope->amount = amount;
+
+    memcpy(batch->hashes[G_context.hashes_count], G_context.hash, HASH_SIZE);
+    G_context.hashes_count++;
+    return true;
+}
+
+// Drop the batch being received, its next chunks are rejected
+static int abort_tx_batch(uint16_t sw) {
+    explicit_bzero(&G_context, sizeof(G_context));
+    return io_send_sw(sw);
+}
+
+int handler_sign_tx_batch(buffer_t *cdata, bool is_first_chunk, bool more, bool more_envelopes) {
+    PRINTF("handler_sign_tx_batch invoked\n");
+    if (is_first_chunk) {
+        explicit_bzero(&G_context, sizeof(G_context));
+        G_context.req_type = CONFIRM_TRANSACTION_BATCH;
+        G_context.state = STATE_RECEIVING;
+
+        if (!buffer_read_u8(cdata, &G_context.bip32_path_len) ||
+            !buffer_read_bip32_path(cdata,
+                                    G_context.bip32_path,
+                                    (size_t) G_context.bip32_path_len)) {
+            return abort_tx_batch(SW_WRONG_DATA_LENGTH);
+        }
+        cx_sha256_init(&G_context.hash_ctx);
+    } else if (G_context.req_type != CONFIRM_TRANSACTION_BATCH ||
+               G_context.state != STATE_RECEIVING) {
+        return io_send_sw(SW_BAD_STATE);
+    }
+
+    // each envelope is received at the start of the raw transaction buffer
+    tx_ctx_t *tx_ctx = &G_context.tx_info;
+    size_t chunk_length = cdata->size - cdata->offset;
+    if (tx_ctx->raw_size + chunk_length > BATCH_ENVELOPE_MAX_SIZE ||
+        G_context.hashes_count == BATCH_MAX_COUNT) {
+        return abort_tx_batch(SW_WRONG_TX_LENGTH);
+    }
+    uint8_t *chunk = tx_ctx->raw + tx_ctx->raw_size;
+    memcpy(chunk, cdata->ptr + cdata->offset, chunk_length);
+    tx_ctx->raw_size += chunk_length;
+    STATS_ADD(STATS_HASHED_BYTES, chunk_length);
+    cx_hash(&G_context.hash_ctx.header, 0, chunk, chunk_length, NULL, 0);
+    parse_tx_xdr_prefix(tx_ctx->raw, tx_ctx->raw_size, tx_ctx);
+
+    if (more) {
+        return io_send_sw(SW_OK);
+    }
+
+    if (cx_hash(&G_context.hash_ctx.header, CX_LAST, NULL, 0, G_context.hash, HASH_SIZE) !=
+        HASH_SIZE) {
+        return abort_tx_batch(SW_TX_HASH_FAIL);
+    }
+    if (!validate_tx_xdr(tx_ctx->raw, tx_ctx->raw_size, tx_ctx)) {
+        return abort_tx_batch(SW_TX_PARSING_FAIL);
+    }
+    if (!add_to_batch()) {
+        return abort_tx_batch(SW_TX_BATCH_FAIL);
+    }
+
+    // the next envelope starts over
+    tx_ctx->raw_size = 0;
+    cx_sha256_init(&G_context.hash_ctx);
+    if (more_envelopes) {
+        return io_send_sw(SW_OK);
+    }
+
+    G_context.state = STATE_PARSED;
+    // the private key is only derived once the batch is approved
+    crypto_get_public_key(G_context.bip32_path, G_context.bip32_path_len, G_context.raw_public_key);
+
+    return ui_approve_tx_batch_init();
+}
+
+int handler_send_tx_batch_signatures() {
+    PRINTF("handler_send_tx_batch_signatures invoked\n");
+    if (G_context.req_type != CONFIRM_TRANSACTION_BATCH || G_context.state != STATE_APPROVED) {
+        return io_send_sw(SW_BAD_STATE);
+    }
+    return send_response_hashes_sigs();
+}
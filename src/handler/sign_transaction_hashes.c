@@ -0,0 +1,99 @@
+/*****************************************************************************
+ *   Ledger Stellar App.
+ *   (c) 2022 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <string.h>  // memcpy, explicit_bzero
+
+#include "./handler.h"
+#include "../globals.h"
+#include "../settings.h"
+#include "../sw.h"
+#include "../stats.h"
+#include "../crypto.h"
+#include "../io.h"
+#include "../send_response.h"
+#include "../ui/ui.h"
+
+// Drop the batch being received, its next chunks are rejected
+static int abort_tx_hashes(uint16_t sw) {
+    explicit_bzero(&G_context, sizeof(G_context));
+    return io_send_sw(sw);
+}
+
+int handler_sign_tx_hashes(buffer_t *cdata, bool is_first_chunk, bool more) {
+    PRINTF("handler_sign_tx_hashes invoked\n");
+    if (!HAS_SETTING(S_HASH_SIGNING_ENABLED)) {
+        return io_send_sw(SW_TX_HASH_SIGNING_MODE_NOT_ENABLED);
+    }
+
+    if (is_first_chunk) {
+        explicit_bzero(&G_context, sizeof(G_context));
+        G_context.req_type = CONFIRM_TRANSACTION_HASHES;
+        G_context.state = STATE_RECEIVING;
+
+        if (!buffer_read_u8(cdata, &G_context.bip32_path_len) ||
+            !buffer_read_bip32_path(cdata,
+                                    G_context.bip32_path,
+                                    (size_t) G_context.bip32_path_len)) {
+            return abort_tx_hashes(SW_WRONG_DATA_LENGTH);
+        }
+        cx_sha256_init(&G_context.hash_ctx);
+    } else if (G_context.req_type != CONFIRM_TRANSACTION_HASHES ||
+               G_context.state != STATE_RECEIVING) {
+        return io_send_sw(SW_BAD_STATE);
+    }
+
+    // the hashes are kept in the raw transaction buffer until they are signed
+    size_t length = cdata->size - cdata->offset;
+    if (length % HASH_SIZE != 0) {
+        return abort_tx_hashes(SW_WRONG_DATA_LENGTH);
+    }
+    if (G_context.hashes_count + length / HASH_SIZE > HASHES_MAX_COUNT) {
+        return abort_tx_hashes(SW_WRONG_TX_LENGTH);
+    }
+    memcpy(G_context.tx_info.raw + G_context.tx_info.raw_size, cdata->ptr + cdata->offset, length);
+    G_context.tx_info.raw_size += length;
+    G_context.hashes_count += length / HASH_SIZE;
+    STATS_ADD(STATS_HASHED_BYTES, length);
+    // the review shows the digest of all the hashes of the batch
+    cx_hash(&G_context.hash_ctx.header, 0, cdata->ptr + cdata->offset, length, NULL, 0);
+
+    if (more) {
+        return io_send_sw(SW_OK);
+    }
+
+    if (G_context.hashes_count == 0) {
+        return abort_tx_hashes(SW_WRONG_DATA_LENGTH);
+    }
+    if (cx_hash(&G_context.hash_ctx.header, CX_LAST, NULL, 0, G_context.hash, HASH_SIZE) !=
+        HASH_SIZE) {
+        return abort_tx_hashes(SW_TX_HASH_FAIL);
+    }
+    G_context.state = STATE_PARSED;
+
+    // the private key is only derived once the batch is approved
+    crypto_get_public_key(G_context.bip32_path, G_context.bip32_path_len, G_context.raw_public_key);
+
+    return ui_approve_tx_hash_init();
+}
+
+int handler_send_tx_hashes_signatures() {
+    PRINTF("handler_send_tx_hashes_signatures invoked\n");
+    if (G_context.req_type != CONFIRM_TRANSACTION_HASHES || G_context.state != STATE_APPROVED) {
+        return io_send_sw(SW_BAD_STATE);
+    }
+    return send_response_hashes_sigs();
+}
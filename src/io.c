@@ -23,6 +23,7 @@
 #include "./globals.h"
 #include "./common/buffer.h"
 #include "./common/write.h"
+#include "./ui/ui.h"
 
 void io_seproxyhal_display(const bagl_element_t *element) {
     io_seproxyhal_display_default((bagl_element_t *) element);
@@ -45,6 +46,8 @@ uint8_t io_event(uint8_t channel __attribute__((unused))) {
             break;
         case SEPROXYHAL_TAG_TICKER_EVENT:
             UX_TICKER_EVENT(G_io_seproxyhal_spi_buffer, {});
+            // use the time the user spends reading to render the next screen
+            ui_approve_tx_prerender();
             break;
         default:
             UX_DEFAULT_EVENT();
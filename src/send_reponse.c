@@ -15,9 +15,12 @@
  *  limitations under the License.
  *****************************************************************************/
 
+#include <string.h>  // explicit_bzero
+
 #include "./send_response.h"
 #include "./globals.h"
 #include "./sw.h"
+#include "./crypto.h"
 #include "./common/buffer.h"
 
 int send_response_pubkey() {
@@ -27,7 +30,89 @@ int send_response_pubkey() {
                             SW_OK);
 }
 
+int send_response_pubkeys() {
+    uint8_t resp[PUBLIC_KEYS_PER_RESPONSE * RAW_ED25519_PUBLIC_KEY_SIZE] = {0};
+    size_t offset = 0;
+
+    while (G_context.public_keys_count > 0 && offset < sizeof(resp)) {
+        // the last component of the path is the index in the range
+        G_context.bip32_path[G_context.bip32_path_len - 1] = G_context.public_keys_index;
+        crypto_get_public_key(G_context.bip32_path, G_context.bip32_path_len, resp + offset);
+        offset += RAW_ED25519_PUBLIC_KEY_SIZE;
+        G_context.public_keys_index++;
+        G_context.public_keys_count--;
+    }
+
+    return io_send_response(&(const buffer_t){.ptr = resp, .size = offset, .offset = 0}, SW_OK);
+}
+
 int send_response_sig(const uint8_t *signature, uint8_t signature_len) {
     return io_send_response(&(const buffer_t){.ptr = signature, .size = signature_len, .offset = 0},
                             SW_OK);
 }
+
+int send_response_hashes_sigs() {
+    uint8_t resp[SIGNATURES_PER_RESPONSE * SIGNATURE_SIZE] = {0};
+    size_t offset = 0;
+    cx_ecfp_private_key_t private_key = {0};
+
+    // the key is only held while signing the hashes of this response
+    crypto_derive_private_key(&private_key, G_context.bip32_path, G_context.bip32_path_len);
+    while (G_context.signed_hashes_count < G_context.hashes_count && offset < sizeof(resp)) {
+        // the hashes of a batch of transactions are kept with their summaries
+        const uint8_t *hash =
+            G_context.req_type == CONFIRM_TRANSACTION_BATCH
+                ? G_context.tx_info.batch.hashes[G_context.signed_hashes_count]
+                : G_context.tx_info.raw + G_context.signed_hashes_count * HASH_SIZE;
+        if (crypto_sign_message_with_key(&private_key,
+                                         hash,
+                                         HASH_SIZE,
+                                         resp + offset,
+                                         SIGNATURE_SIZE) < 0) {
+            explicit_bzero(&private_key, sizeof(private_key));
+            explicit_bzero(&G_context, sizeof(G_context));
+            return io_send_sw(SW_SIGNATURE_FAIL);
+        }
+        offset += SIGNATURE_SIZE;
+        G_context.signed_hashes_count++;
+    }
+    explicit_bzero(&private_key, sizeof(private_key));
+
+    if (G_context.signed_hashes_count == G_context.hashes_count) {
+        // batch completed, its hashes can't be signed again
+        explicit_bzero(&G_context, sizeof(G_context));
+    }
+
+    return io_send_response(&(const buffer_t){.ptr = resp, .size = offset, .offset = 0}, SW_OK);
+}
+
+int send_response_signers_sigs() {
+    uint8_t resp[SIGNATURES_PER_RESPONSE * SIGNATURE_SIZE] = {0};
+    size_t offset = 0;
+
+    while (G_context.signed_signers_count < G_context.signers_count && offset < sizeof(resp)) {
+        const signing_path_t *signer = &G_context.signers[G_context.signed_signers_count];
+        cx_ecfp_private_key_t private_key = {0};
+        // the same hash is signed by each signer, their keys are only held while signing
+        crypto_derive_private_key(&private_key, signer->bip32_path, signer->bip32_path_len);
+        int ret = crypto_sign_message_with_key(&private_key,
+                                               G_context.hash,
+                                               sizeof(G_context.hash),
+                                               resp + offset,
+                                               SIGNATURE_SIZE);
+        explicit_bzero(&private_key, sizeof(private_key));
+        if (ret < 0) {
+            G_context.state = STATE_NONE;
+            return io_send_sw(SW_SIGNATURE_FAIL);
+        }
+        offset += SIGNATURE_SIZE;
+        G_context.signed_signers_count++;
+    }
+
+    if (G_context.signed_signers_count == G_context.signers_count) {
+        // all the signers signed
+        G_context.state = STATE_NONE;
+    }
+
+    return io_send_response(&(const buffer_t){.ptr = resp, .size = offset, .offset = 0}, SW_OK);
+}
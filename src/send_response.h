@@ -12,6 +12,17 @@
  */
 int send_response_pubkey(void);
 
+/**
+ * Helper to derive the next public keys of a range and send APDU response with them.
+ *
+ * response = raw_public_key (RAW_ED25519_PUBLIC_KEY_SIZE) *
+ *            min(PUBLIC_KEYS_PER_RESPONSE, public keys left)
+ *
+ * @return zero or positive integer if success, -1 otherwise.
+ *
+ */
+int send_response_pubkeys(void);
+
 /**
  * Helper to send APDU response with signature.
  *
@@ -19,3 +30,28 @@ int send_response_pubkey(void);
  *
  */
 int send_response_sig(const uint8_t *signature, uint8_t signature_len);
+
+/**
+ * Helper to sign the next hashes of an approved batch of hashes or of transactions and send
+ * APDU response with their signatures.
+ *
+ * response = signature (SIGNATURE_SIZE) * min(SIGNATURES_PER_RESPONSE, hashes left)
+ *
+ * The private key is derived for each response and wiped before it is sent, the context is
+ * reset once the last hash is signed.
+ *
+ * @return zero or positive integer if success, -1 otherwise.
+ *
+ */
+int send_response_hashes_sigs(void);
+
+/**
+ * Helper to sign the approved transaction with the next signers and send APDU response with
+ * their signatures.
+ *
+ * response = signature (SIGNATURE_SIZE) * min(SIGNATURES_PER_RESPONSE, signers left)
+ *
+ * @return zero or positive integer if success, -1 otherwise.
+ *
+ */
+int send_response_signers_sigs(void);
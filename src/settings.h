@@ -26,5 +26,23 @@ extern const internal_storage_t N_storage_real;
 
 #define S_HASH_SIGNING_ENABLED    0
 #define S_SEQUENCE_NUMBER_ENABLED 1
+#define S_VERBOSITY               2  // 2 bits
+
+// review verbosity profiles, which screens each one leaves out is decided by the formatter
+#define VERBOSITY_FULL           0  // every screen, the default
+#define VERBOSITY_STANDARD       1  // without the sources equal to the signer or to the tx source
+#define VERBOSITY_COMPACT        2  // also without the fee at the base fee
+#define VERBOSITY_PROFILES_COUNT 3
+
+// the review verbosity profile
+#define VERBOSITY_PROFILE() ((N_settings >> S_VERBOSITY) & 0x03)
+
+// set the review verbosity profile
+#define SETTING_SET_VERBOSITY(_profile)                                                        \
+    do {                                                                                       \
+        internal_storage_t _temp_settings =                                                    \
+            (N_settings & ~(0x03 << S_VERBOSITY)) | ((_profile) << S_VERBOSITY);               \
+        nvm_write((void *) &N_settings, (void *) &_temp_settings, sizeof(internal_storage_t)); \
+    } while (0)
 
 #define S_INITIALIZED 7
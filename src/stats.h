@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Counters of the work done by the app, read and reset with INS_GET_STATS. They are only
+ * kept in debug builds (HAVE_STATS), the macros below compile to nothing otherwise.
+ */
+typedef enum {
+    STATS_HASHED_BYTES,          // bytes of envelopes and hashes received and hashed
+    STATS_TX_PARSES,             // envelope parses, from its start or from an operation offset
+    STATS_OPERATION_PARSES,      // operations parsed
+    STATS_BACK_REPARSES,         // operations parsed again when paging back through the review
+    STATS_KEY_DERIVATIONS,       // private keys derived from a BIP32 path
+    STATS_SIGNATURES,            // signatures computed
+    STATS_RENDERED_SCREENS,      // screens filled by their formatter
+    STATS_RENDERED_SCREEN_HITS,  // screens copied from the rendered screens instead
+    STATS_PRERENDERED_SCREENS,   // screens rendered ahead while the previous one is displayed
+    STATS_ENCODED_STRKEYS,       // StrKeys encoded, not found in the cache
+    STATS_COUNTERS_COUNT
+} stats_counter_e;
+
+#ifdef HAVE_STATS
+extern uint32_t G_stats[STATS_COUNTERS_COUNT];
+
+#define STATS_ADD(counter, n) (G_stats[counter] += (n))
+#else
+#define STATS_ADD(counter, n)
+#endif
+
+#define STATS_INC(counter) STATS_ADD(counter, 1)
@@ -90,6 +90,11 @@
  */
 #define SW_SWAP_CHECKING_FAIL 0xB009
 
+/**
+ * Status word for an envelope which can't be reviewed as part of a batch
+ */
+#define SW_TX_BATCH_FAIL 0xB00A
+
 /**
  * Status word for success.
  */
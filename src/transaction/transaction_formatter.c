@@ -28,6 +28,7 @@
 #include "../types.h"
 #include "../globals.h"
 #include "../settings.h"
+#include "../stats.h"
 #include "../common/format.h"
 #include "../transaction/transaction_parser.h"
 
@@ -54,10 +55,110 @@
 
 static const char *NETWORK_NAMES[3] = {"Public", "Testnet", "Unknown"};
 
+/* fee of each operation when the network isn't congested, in stroops */
+#define BASE_FEE 100
+
+/* width in pixels of a bnnn_paging line between its arrows, two short fields sharing a screen
+ * are paired only when each line fits in it */
+#define PAIRED_LINE_WIDTH 114
+
+/* screens the verbosity profiles can leave out of the review, when they are redundant */
+typedef enum {
+    ELIDABLE_FEE,        // at the base fee of the operations
+    ELIDABLE_TX_SOURCE,  // equal to the signer
+    ELIDABLE_OP_SOURCE,  // equal to the tx source
+} elidable_screen_e;
+
+#define ELIDE(screen) (1 << (screen))
+
+// indexed by the 2 bits of the profile, the unused value shows everything
+static const uint8_t ELIDED_SCREENS[4] = {
+    [VERBOSITY_FULL] = 0,
+    [VERBOSITY_STANDARD] = ELIDE(ELIDABLE_TX_SOURCE) | ELIDE(ELIDABLE_OP_SOURCE),
+    [VERBOSITY_COMPACT] =
+        ELIDE(ELIDABLE_FEE) | ELIDE(ELIDABLE_TX_SOURCE) | ELIDE(ELIDABLE_OP_SOURCE),
+};
+
+#ifdef TEST
+uint8_t verbosity_profile = VERBOSITY_FULL;  // every screen, unless a test chooses a profile
+#define REVIEW_VERBOSITY() verbosity_profile
+#else
+#define REVIEW_VERBOSITY() VERBOSITY_PROFILE()
+#endif  // TEST
+
 char op_caption[OPERATION_CAPTION_MAX_LENGTH];
 format_function_t formatter_stack[MAX_FORMATTERS_PER_OPERATION];
 int8_t formatter_index;
 
+#ifdef HAVE_RENDERED_SCREENS
+typedef struct {
+    format_function_t formatter;  // formatter of the screen, NULL if the entry is unused
+    format_function_t next;       // formatter it pushed for the following screen
+    uint8_t data_index;
+    int8_t formatter_index;
+    char caption[DETAIL_CAPTION_MAX_LENGTH];
+    char value[DETAIL_VALUE_MAX_LENGTH];
+} rendered_screen_t;
+
+static rendered_screen_t rendered_screens[RENDERED_SCREENS_COUNT];
+static uint8_t rendered_screens_next;  // entry replaced by the next rendered screen
+static bool prerendering;              // the screen rendered isn't displayed yet
+#endif
+
+// Whether the key is the account of the signing path, or of one of the signing paths
+static bool is_signer(const uint8_t *key) {
+    if (G_context.signers_count == 0) {
+        return memcmp(key, G_context.raw_public_key, RAW_ED25519_PUBLIC_KEY_SIZE) == 0;
+    }
+    for (uint8_t i = 0; i < G_context.signers_count; i++) {
+        if (memcmp(key, G_context.signers[i].raw_public_key, RAW_ED25519_PUBLIC_KEY_SIZE) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool is_tx_source_signer(const tx_ctx_t *tx_ctx) {
+    return tx_ctx->envelope_type == ENVELOPE_TYPE_TX &&
+           tx_ctx->tx_details.source_account.type == KEY_TYPE_ED25519 &&
+           is_signer(tx_ctx->tx_details.source_account.ed25519);
+}
+
+static bool same_muxed_account(const muxed_account_t *a, const muxed_account_t *b) {
+    if (a->type != b->type) {
+        return false;
+    }
+    if (a->type == KEY_TYPE_MUXED_ED25519) {
+        return a->med25519.id == b->med25519.id &&
+               memcmp(a->med25519.ed25519, b->med25519.ed25519, RAW_ED25519_PUBLIC_KEY_SIZE) == 0;
+    }
+    return memcmp(a->ed25519, b->ed25519, RAW_ED25519_PUBLIC_KEY_SIZE) == 0;
+}
+
+static bool is_redundant(const tx_ctx_t *tx_ctx, elidable_screen_e screen) {
+    const transaction_details_t *tx_details = &tx_ctx->tx_details;
+    switch (screen) {
+        case ELIDABLE_FEE:
+            return tx_details->fee == (uint32_t) BASE_FEE * tx_details->operations_count;
+        case ELIDABLE_TX_SOURCE:
+            return is_tx_source_signer(tx_ctx);
+        case ELIDABLE_OP_SOURCE:
+            return same_muxed_account(&tx_details->op_details.source_account,
+                                      &tx_details->source_account);
+        default:
+            return false;
+    }
+}
+
+/*
+ * The rules of the verbosity profiles: a screen is left out when the profile allows it and its
+ * value is the redundant one.
+ */
+static bool is_elided(const tx_ctx_t *tx_ctx, elidable_screen_e screen) {
+    return (ELIDED_SCREENS[REVIEW_VERBOSITY()] & ELIDE(screen)) != 0 &&
+           is_redundant(tx_ctx, screen);
+}
+
 static void push_to_formatter_stack(format_function_t formatter) {
     if (formatter_index + 1 >= MAX_FORMATTERS_PER_OPERATION) {
         THROW(SW_TX_FORMATTING_FAIL);
@@ -67,17 +168,20 @@ static void push_to_formatter_stack(format_function_t formatter) {
 
 static void format_next_step(tx_ctx_t *tx_ctx) {
     (void) tx_ctx;
+    // elided screens can end the item from a prepare function, the next item is only rendered
+    // once the user pages to it
+#ifdef HAVE_RENDERED_SCREENS
+    if (prerendering) {
+        return;
+    }
+#endif
     formatter_stack[formatter_index] = NULL;
     set_state_data(true);
 }
 
 static void format_transaction_source(tx_ctx_t *tx_ctx) {
     STRLCPY(G_ui_detail_caption, "Tx Source", DETAIL_CAPTION_MAX_LENGTH);
-    if (tx_ctx->envelope_type == ENVELOPE_TYPE_TX &&
-        tx_ctx->tx_details.source_account.type == KEY_TYPE_ED25519 &&
-        memcmp(tx_ctx->tx_details.source_account.ed25519,
-               G_context.raw_public_key,
-               RAW_ED25519_PUBLIC_KEY_SIZE) == 0) {
+    if (is_tx_source_signer(tx_ctx)) {
         FORMATTER_CHECK(print_muxed_account(&tx_ctx->tx_details.source_account,
                                             G_ui_detail_value,
                                             DETAIL_VALUE_MAX_LENGTH,
@@ -93,17 +197,25 @@ static void format_transaction_source(tx_ctx_t *tx_ctx) {
     push_to_formatter_stack(format_next_step);
 }
 
+static void format_transaction_source_prepare(tx_ctx_t *tx_ctx) {
+    if (is_elided(tx_ctx, ELIDABLE_TX_SOURCE)) {
+        format_next_step(tx_ctx);
+    } else {
+        format_transaction_source(tx_ctx);
+    }
+}
+
 static void format_min_seq_ledger_gap(tx_ctx_t *tx_ctx) {
     STRLCPY(G_ui_detail_caption, "Min Seq Ledger Gap", DETAIL_CAPTION_MAX_LENGTH);
     FORMATTER_CHECK(print_uint(tx_ctx->tx_details.cond.min_seq_ledger_gap,
                                G_ui_detail_value,
                                DETAIL_VALUE_MAX_LENGTH))
-    push_to_formatter_stack(&format_transaction_source);
+    push_to_formatter_stack(&format_transaction_source_prepare);
 }
 
 static void format_min_seq_ledger_gap_prepare(tx_ctx_t *tx_ctx) {
     if (tx_ctx->tx_details.cond.min_seq_ledger_gap == 0) {
-        format_transaction_source(tx_ctx);
+        format_transaction_source_prepare(tx_ctx);
     } else {
         format_min_seq_ledger_gap(tx_ctx);
     }
@@ -211,6 +323,17 @@ static void format_sequence(tx_ctx_t *tx_ctx) {
     push_to_formatter_stack(&format_time_bounds);
 }
 
+static format_function_t get_sequence_formatter(void) {
+#ifdef TEST
+    return &format_sequence;
+#else
+    if (HAS_SETTING(S_SEQUENCE_NUMBER_ENABLED)) {
+        return &format_sequence;
+    }
+    return &format_time_bounds;
+#endif  // TEST
+}
+
 static void format_fee(tx_ctx_t *tx_ctx) {
     STRLCPY(G_ui_detail_caption, "Max Fee", DETAIL_CAPTION_MAX_LENGTH);
     asset_t asset = {.type = ASSET_TYPE_NATIVE};
@@ -219,15 +342,15 @@ static void format_fee(tx_ctx_t *tx_ctx) {
                                  tx_ctx->network,
                                  G_ui_detail_value,
                                  DETAIL_VALUE_MAX_LENGTH))
-#ifdef TEST
-    push_to_formatter_stack(&format_sequence);
-#else
-    if (HAS_SETTING(S_SEQUENCE_NUMBER_ENABLED)) {
-        push_to_formatter_stack(&format_sequence);
+    push_to_formatter_stack(get_sequence_formatter());
+}
+
+static void format_fee_prepare(tx_ctx_t *tx_ctx) {
+    if (is_elided(tx_ctx, ELIDABLE_FEE)) {
+        get_sequence_formatter()(tx_ctx);
     } else {
-        push_to_formatter_stack(&format_time_bounds);
+        format_fee(tx_ctx);
     }
-#endif  // TEST
 }
 
 static void format_memo(tx_ctx_t *tx_ctx) {
@@ -280,7 +403,7 @@ static void format_memo(tx_ctx_t *tx_ctx) {
             THROW(SW_TX_FORMATTING_FAIL);
             return;
     }
-    push_to_formatter_stack(&format_fee);
+    push_to_formatter_stack(&format_fee_prepare);
 }
 
 static void format_transaction_details(tx_ctx_t *tx_ctx) {
@@ -296,7 +419,7 @@ static void format_transaction_details(tx_ctx_t *tx_ctx) {
     if (tx_ctx->tx_details.memo.type != MEMO_NONE) {
         push_to_formatter_stack(&format_memo);
     } else {
-        push_to_formatter_stack(&format_fee);
+        push_to_formatter_stack(&format_fee_prepare);
     }
 }
 
@@ -305,12 +428,8 @@ static void format_operation_source(tx_ctx_t *tx_ctx) {
     if (tx_ctx->envelope_type == ENVELOPE_TYPE_TX &&
         tx_ctx->tx_details.source_account.type == KEY_TYPE_ED25519 &&
         tx_ctx->tx_details.op_details.source_account.type == KEY_TYPE_ED25519 &&
-        memcmp(tx_ctx->tx_details.source_account.ed25519,
-               G_context.raw_public_key,
-               RAW_ED25519_PUBLIC_KEY_SIZE) == 0 &&
-        memcmp(tx_ctx->tx_details.op_details.source_account.ed25519,
-               G_context.raw_public_key,
-               RAW_ED25519_PUBLIC_KEY_SIZE) == 0) {
+        is_signer(tx_ctx->tx_details.source_account.ed25519) &&
+        is_signer(tx_ctx->tx_details.op_details.source_account.ed25519)) {
         FORMATTER_CHECK(print_muxed_account(&tx_ctx->tx_details.op_details.source_account,
                                             G_ui_detail_value,
                                             DETAIL_VALUE_MAX_LENGTH,
@@ -334,7 +453,8 @@ static void format_operation_source(tx_ctx_t *tx_ctx) {
 }
 
 static void format_operation_source_prepare(tx_ctx_t *tx_ctx) {
-    if (tx_ctx->tx_details.op_details.source_account_present) {
+    if (tx_ctx->tx_details.op_details.source_account_present &&
+        !is_elided(tx_ctx, ELIDABLE_OP_SOURCE)) {
         // If the source exists, when the user clicks the next button,
         // it will jump to the page showing the source
         push_to_formatter_stack(&format_operation_source);
@@ -453,10 +573,17 @@ static void format_allow_trust_authorize(tx_ctx_t *tx_ctx) {
 }
 
 static void format_allow_trust_asset_code(tx_ctx_t *tx_ctx) {
+    const allow_trust_op_t *op = &tx_ctx->tx_details.op_details.allow_trust_op;
+    asset_t asset = {.type = op->asset_type};
+    if (asset.type == ASSET_TYPE_CREDIT_ALPHANUM4) {
+        asset.alpha_num4.asset_code = op->asset_code;
+    } else {
+        asset.alpha_num12.asset_code = op->asset_code;
+    }
+
     STRLCPY(G_ui_detail_caption, "Asset Code", DETAIL_CAPTION_MAX_LENGTH);
-    STRLCPY(G_ui_detail_value,
-            tx_ctx->tx_details.op_details.allow_trust_op.asset_code,
-            DETAIL_VALUE_MAX_LENGTH);
+    FORMATTER_CHECK(
+        print_asset_name(&asset, tx_ctx->network, G_ui_detail_value, DETAIL_VALUE_MAX_LENGTH))
     push_to_formatter_stack(&format_allow_trust_authorize);
 }
 
@@ -1619,30 +1746,10 @@ static void format_liquidity_pool_withdraw(tx_ctx_t *tx_ctx) {
     push_to_formatter_stack(&format_liquidity_pool_withdraw_liquidity_pool_id);
 }
 
-static const format_function_t formatters[] = {&format_create_account,
-                                               &format_payment,
-                                               &format_path_payment_strict_receive,
-                                               &format_manage_sell_offer,
-                                               &format_create_passive_sell_offer,
-                                               &format_set_options,
-                                               &format_change_trust,
-                                               &format_allow_trust,
-                                               &format_account_merge,
-                                               &format_inflation,
-                                               &format_manage_data,
-                                               &format_bump_sequence,
-                                               &format_manage_buy_offer,
-                                               &format_path_payment_strict_send,
-                                               &format_create_claimable_balance,
-                                               &format_claim_claimable_balance,
-                                               &format_begin_sponsoring_future_reserves,
-                                               &format_end_sponsoring_future_reserves,
-                                               &format_revoke_sponsorship,
-                                               &format_clawback,
-                                               &format_clawback_claimable_balance,
-                                               &format_set_trust_line_flags,
-                                               &format_liquidity_pool_deposit,
-                                               &format_liquidity_pool_withdraw};
+#define OPERATION_FORMATTERS_ENTRY(id, TYPE, name) [id] = &format_##name,
+
+static const format_function_t formatters[OPERATION_TYPES_COUNT] = {
+    OPERATION_TYPES(OPERATION_FORMATTERS_ENTRY, OPERATION_FORMATTERS_ENTRY)};
 
 void format_confirm_operation(tx_ctx_t *tx_ctx) {
     if (tx_ctx->tx_details.operations_count > 1) {
@@ -1679,9 +1786,7 @@ static void format_fee_bump_transaction_source(tx_ctx_t *tx_ctx) {
     STRLCPY(G_ui_detail_caption, "Fee Source", DETAIL_CAPTION_MAX_LENGTH);
     if (tx_ctx->envelope_type == ENVELOPE_TYPE_TX_FEE_BUMP &&
         tx_ctx->fee_bump_tx_details.fee_source.type == KEY_TYPE_ED25519 &&
-        memcmp(tx_ctx->fee_bump_tx_details.fee_source.ed25519,
-               G_context.raw_public_key,
-               RAW_ED25519_PUBLIC_KEY_SIZE) == 0) {
+        is_signer(tx_ctx->fee_bump_tx_details.fee_source.ed25519)) {
         FORMATTER_CHECK(print_muxed_account(&tx_ctx->fee_bump_tx_details.fee_source,
                                             G_ui_detail_value,
                                             DETAIL_VALUE_MAX_LENGTH,
@@ -1713,7 +1818,7 @@ static format_function_t get_tx_details_formatter(tx_ctx_t *tx_ctx) {
         if (tx_ctx->tx_details.memo.type != MEMO_NONE) {
             return &format_memo;
         } else {
-            return &format_fee;
+            return &format_fee_prepare;
         }
     }
 
@@ -1730,7 +1835,7 @@ static void format_network(tx_ctx_t *tx_ctx) {
     push_to_formatter_stack(formatter);
 }
 
-static format_function_t get_tx_formatter(tx_ctx_t *tx_ctx) {
+static format_function_t get_network_formatter(tx_ctx_t *tx_ctx) {
     if (tx_ctx->network != 0) {
         return &format_network;
     } else {
@@ -1738,26 +1843,61 @@ static format_function_t get_tx_formatter(tx_ctx_t *tx_ctx) {
     }
 }
 
+// The signers are the first screens of the transaction details, one per formatter index
+static void format_signer(tx_ctx_t *tx_ctx) {
+    uint8_t index = formatter_index;
+    size_t len;
+
+    FORMATTER_CHECK(index < G_context.signers_count)
+    STRLCPY(G_ui_detail_caption, "Signer ", DETAIL_CAPTION_MAX_LENGTH);
+    len = strlen(G_ui_detail_caption);
+    FORMATTER_CHECK(
+        print_uint(index + 1, G_ui_detail_caption + len, DETAIL_CAPTION_MAX_LENGTH - len))
+    STRLCAT(G_ui_detail_caption, " of ", DETAIL_CAPTION_MAX_LENGTH);
+    len = strlen(G_ui_detail_caption);
+    FORMATTER_CHECK(print_uint(G_context.signers_count,
+                               G_ui_detail_caption + len,
+                               DETAIL_CAPTION_MAX_LENGTH - len))
+    FORMATTER_CHECK(encode_ed25519_public_key(G_context.signers[index].raw_public_key,
+                                              G_ui_detail_value,
+                                              DETAIL_VALUE_MAX_LENGTH))
+    if (index + 1 < G_context.signers_count) {
+        push_to_formatter_stack(&format_signer);
+    } else {
+        push_to_formatter_stack(get_network_formatter(tx_ctx));
+    }
+}
+
+static format_function_t get_tx_formatter(tx_ctx_t *tx_ctx) {
+    // the user approves the account of each signer when several paths sign
+    if (G_context.signers_count > 1) {
+        return &format_signer;
+    }
+    return get_network_formatter(tx_ctx);
+}
+
 format_function_t get_formatter(tx_ctx_t *tx_ctx, bool forward) {
     if (!forward) {
         if (G_ui_current_data_index ==
             0) {  // if we're already at the beginning of the buffer, return NULL
             return NULL;
         }
-        // rewind to tx beginning if we're requesting a previous operation
-        tx_ctx->offset = 0;
-        tx_ctx->tx_details.operation_index = 0;
     }
 
     if (G_ui_current_data_index == 1) {
         return get_tx_formatter(tx_ctx);
     }
 
-    // 1 == data_count_before_ops
-    while (G_ui_current_data_index - 1 > tx_ctx->tx_details.operation_index) {
-        if (!parse_tx_xdr(tx_ctx->raw, tx_ctx->raw_size, tx_ctx)) {
-            return NULL;
-        }
+    // 1 == data_count_before_ops, the operation offsets recorded by the parser let us seek
+    // to the requested operation in both directions
+    if (!forward) {
+        STATS_INC(STATS_BACK_REPARSES);
+    }
+    if (!parse_tx_xdr_operation(tx_ctx->raw,
+                                tx_ctx->raw_size,
+                                tx_ctx,
+                                G_ui_current_data_index - 2)) {
+        return NULL;
     }
     return &format_confirm_operation;
 }
@@ -1780,24 +1920,275 @@ void ui_approve_tx_prev_screen(tx_ctx_t *tx_ctx) {
     }
 }
 
+void reset_rendered_screens(void) {
+#ifdef HAVE_RENDERED_SCREENS
+    explicit_bzero(rendered_screens, sizeof(rendered_screens));
+    rendered_screens_next = 0;
+#endif
+}
+
+#ifdef HAVE_RENDERED_SCREENS
+static const rendered_screen_t *find_rendered_screen(int8_t index) {
+    for (uint8_t i = 0; i < RENDERED_SCREENS_COUNT; i++) {
+        const rendered_screen_t *screen = &rendered_screens[i];
+        if (screen->formatter != NULL && screen->formatter == formatter_stack[index] &&
+            screen->data_index == G_ui_current_data_index && screen->formatter_index == index) {
+            return screen;
+        }
+    }
+    return NULL;
+}
+#endif
+
+/*
+ * Formatters of a single short field which only push the formatter of the next screen, the
+ * screen before them can be rendered along with them.
+ */
+static const format_function_t PAIRABLE_FORMATTERS[] = {
+    &format_sequence,
+    &format_min_seq_num,
+    &format_min_seq_age,
+    &format_min_seq_ledger_gap,
+    &format_ledger_bounds_min_ledger,
+    &format_ledger_bounds_max_ledger,
+    &format_bump_sequence_bump_to,
+    &format_set_option_signer_weight,
+    &format_set_option_high_threshold,
+    &format_set_option_medium_threshold,
+    &format_set_option_low_threshold,
+    &format_set_option_master_weight,
+    &format_set_option_set_flags,
+    &format_set_option_clear_flags,
+    &format_set_trust_line_set_flags,
+};
+
+static bool is_pairable(format_function_t formatter) {
+    for (size_t i = 0; i < sizeof(PAIRABLE_FORMATTERS) / sizeof(PAIRABLE_FORMATTERS[0]); i++) {
+        if ((format_function_t) PIC(PAIRABLE_FORMATTERS[i]) == formatter) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Whether a line fits between the arrows of bnnn_paging, in its title or text font
+static bool fits_line(const char *line, bool title) {
+    unsigned short font_id =
+        title ? BAGL_FONT_OPEN_SANS_EXTRABOLD_11px : BAGL_FONT_OPEN_SANS_REGULAR_11px;
+    return bagl_compute_line_width(font_id, 0, line, strlen(line), BAGL_ENCODING_LATIN1) <=
+           PAIRED_LINE_WIDTH;
+}
+
+/*
+ * Render the next screen along with the one just rendered when it is a short field and both
+ * fit on one line as "Caption: value", the first as the title and the second as the text.
+ * The pair takes the formatter index of the first screen, the screen counts stay consistent.
+ */
+static void pair_next_screen(void) {
+    int8_t index = formatter_index;
+    char title[DETAIL_CAPTION_MAX_LENGTH];
+
+    if (index + 1 >= MAX_FORMATTERS_PER_OPERATION || !is_pairable(formatter_stack[index + 1])) {
+        return;
+    }
+    // a caption and value too long for the title keep their own screen
+    if (strlcpy(title, G_ui_detail_caption, sizeof(title)) >= sizeof(title) ||
+        strlcat(title, ": ", sizeof(title)) >= sizeof(title) ||
+        strlcat(title, G_ui_detail_value, sizeof(title)) >= sizeof(title) ||
+        !fits_line(title, true)) {
+        return;
+    }
+
+    format_function_t second = formatter_stack[index + 1];
+    explicit_bzero(G_ui_detail_caption, sizeof(G_ui_detail_caption));
+    explicit_bzero(G_ui_detail_value, sizeof(G_ui_detail_value));
+    second(&G_context.tx_info);
+
+    size_t caption_len = strlen(G_ui_detail_caption);
+    size_t value_len = strlen(G_ui_detail_value);
+    if (caption_len + 2 + value_len < sizeof(G_ui_detail_value)) {
+        memmove(G_ui_detail_value + caption_len + 2, G_ui_detail_value, value_len + 1);
+        memcpy(G_ui_detail_value, G_ui_detail_caption, caption_len);
+        memcpy(G_ui_detail_value + caption_len, ": ", 2);
+        if (fits_line(G_ui_detail_value, false)) {
+            memcpy(G_ui_detail_caption, title, sizeof(G_ui_detail_caption));
+            return;
+        }
+    }
+    // too wide: the first screen is rendered again, it pushes the second one back
+    explicit_bzero(G_ui_detail_caption, sizeof(G_ui_detail_caption));
+    explicit_bzero(G_ui_detail_value, sizeof(G_ui_detail_value));
+    formatter_stack[index](&G_context.tx_info);
+}
+
+// Apply the formatter at formatter_index to fill the screen's buffer
+static void render_screen(void) {
+    format_function_t formatter = formatter_stack[formatter_index];
+    uint8_t data_index = G_ui_current_data_index;
+    int8_t index = formatter_index;
+
+    STATS_INC(STATS_RENDERED_SCREENS);
+    explicit_bzero(G_ui_detail_caption, sizeof(G_ui_detail_caption));
+    explicit_bzero(G_ui_detail_value, sizeof(G_ui_detail_value));
+    explicit_bzero(op_caption, sizeof(op_caption));
+#ifdef HAVE_STRKEY_CACHE
+    // accounts repeated across operations and pages are only encoded once, the cache isn't
+    // left set by a formatting error
+    set_strkey_cache(&G_context.tx_info.strkey_cache);
+    BEGIN_TRY {
+        TRY {
+            formatter(&G_context.tx_info);
+        }
+        FINALLY {
+            set_strkey_cache(NULL);
+        }
+    }
+    END_TRY;
+#else
+    formatter(&G_context.tx_info);
+#endif
+
+    if (op_caption[0] != '\0') {
+        STRLCPY(G_ui_detail_caption, op_caption, sizeof(G_ui_detail_caption));
+        G_ui_detail_value[0] = ' ';
+    }
+
+    // format_next_step renders the first screen of the next item instead, nothing to keep
+    if (G_ui_current_data_index != data_index || formatter_index != index ||
+        G_ui_detail_caption[0] == '\0') {
+        return;
+    }
+    if (op_caption[0] == '\0') {
+        pair_next_screen();
+    }
+#ifdef HAVE_RENDERED_SCREENS
+    rendered_screen_t *screen = &rendered_screens[rendered_screens_next];
+    screen->formatter = formatter;
+    screen->next =
+        index + 1 < MAX_FORMATTERS_PER_OPERATION ? formatter_stack[index + 1] : NULL;
+    screen->data_index = data_index;
+    screen->formatter_index = index;
+    memcpy(screen->caption, G_ui_detail_caption, sizeof(screen->caption));
+    memcpy(screen->value, G_ui_detail_value, sizeof(screen->value));
+    rendered_screens_next = (rendered_screens_next + 1) % RENDERED_SCREENS_COUNT;
+#endif
+}
+
 void set_state_data(bool forward) {
     PRINTF("set_state_data invoked, forward = %d\n", forward);
+#ifdef HAVE_RENDERED_SCREENS
+    // a formatting error may have interrupted prerender_next_screen
+    prerendering = false;
+#endif
     if (forward) {
         ui_approve_tx_next_screen(&G_context.tx_info);
     } else {
         ui_approve_tx_prev_screen(&G_context.tx_info);
     }
 
-    // Apply last formatter to fill the screen's buffer
-    if (formatter_stack[formatter_index]) {
-        explicit_bzero(G_ui_detail_caption, sizeof(G_ui_detail_caption));
-        explicit_bzero(G_ui_detail_value, sizeof(G_ui_detail_value));
-        explicit_bzero(op_caption, sizeof(op_caption));
-        formatter_stack[formatter_index](&G_context.tx_info);
+    if (!formatter_stack[formatter_index]) {
+        return;
+    }
+#ifndef HAVE_RENDERED_SCREENS
+    render_screen();
+#else
+    const rendered_screen_t *screen = find_rendered_screen(formatter_index);
+    if (screen == NULL) {
+        render_screen();
+        return;
+    }
+    // already rendered: copy it and push the formatter it pushed
+    STATS_INC(STATS_RENDERED_SCREEN_HITS);
+    memcpy(G_ui_detail_caption, screen->caption, sizeof(G_ui_detail_caption));
+    memcpy(G_ui_detail_value, screen->value, sizeof(G_ui_detail_value));
+    if (formatter_index + 1 < MAX_FORMATTERS_PER_OPERATION) {
+        formatter_stack[formatter_index + 1] = screen->next;
+    }
+#endif
+}
+
+bool prerender_next_screen(void) {
+#ifndef HAVE_RENDERED_SCREENS
+    return false;
+#else
+    int8_t index = formatter_index;
+    if (index < 0 || index + 1 >= MAX_FORMATTERS_PER_OPERATION ||
+        formatter_stack[index + 1] == NULL || formatter_stack[index + 1] == format_next_step ||
+        find_rendered_screen(index + 1) != NULL) {
+        return false;
+    }
+    // the displayed screen is restored from its rendered copy
+    if (find_rendered_screen(index) == NULL) {
+        return false;
+    }
+    formatter_index = index + 1;
+    STATS_INC(STATS_PRERENDERED_SCREENS);
+    prerendering = true;
+    render_screen();
+    prerendering = false;
+    formatter_index = index;
+    set_state_data(true);
+    return true;
+#endif
+}
+
+bool count_screens(void) {
+    tx_ctx_t *tx_ctx = &G_context.tx_info;
+    uint8_t data_count = tx_ctx->tx_details.operations_count + 1;
+
+    reset_rendered_screens();
+    explicit_bzero(tx_ctx->screen_counts, sizeof(tx_ctx->screen_counts));
+    tx_ctx->screens_count = 0;
+    G_ui_current_data_index = 0;
+    formatter_index = 0;
+    explicit_bzero(formatter_stack, sizeof(formatter_stack));
+
+    // same walk as the review, each set_state_data call fills one screen
+    set_state_data(true);
+    while (formatter_stack[formatter_index] != NULL) {
+        if (G_ui_current_data_index == 0 || G_ui_current_data_index > data_count) {
+            return false;
+        }
+        tx_ctx->screen_counts[G_ui_current_data_index - 1]++;
+        tx_ctx->screens_count++;
 
-        if (op_caption[0] != '\0') {
-            STRLCPY(G_ui_detail_caption, op_caption, sizeof(G_ui_detail_caption));
-            G_ui_detail_value[0] = ' ';
+        formatter_index++;
+        if (formatter_stack[formatter_index] == NULL) {
+            break;
         }
+        set_state_data(true);
+    }
+    if (G_ui_current_data_index != data_count) {
+        return false;
+    }
+
+    G_ui_current_data_index = 0;
+    formatter_index = 0;
+    explicit_bzero(formatter_stack, sizeof(formatter_stack));
+    reset_rendered_screens();
+    return true;
+}
+
+bool render_tx_details_screen(uint8_t index) {
+    if (index >= G_context.tx_info.screen_counts[0]) {
+        return false;
+    }
+    // walked from the first screen, the previous ones are usually still rendered
+    G_ui_current_data_index = 0;
+    formatter_index = 0;
+    explicit_bzero(formatter_stack, sizeof(formatter_stack));
+    set_state_data(true);
+    while (formatter_index < index && formatter_stack[formatter_index] != NULL) {
+        formatter_index++;
+        set_state_data(true);
+    }
+    return G_ui_current_data_index == 1 && formatter_stack[formatter_index] != NULL;
+}
+
+uint16_t get_screen_position(void) {
+    uint16_t position = formatter_index;
+    for (uint8_t i = 0; i + 1 < G_ui_current_data_index; i++) {
+        position += G_context.tx_info.screen_counts[i];
     }
+    return position;
 }
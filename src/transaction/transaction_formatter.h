@@ -15,13 +15,65 @@
  */
 typedef void (*format_function_t)(tx_ctx_t *tx_ctx);
 
-/* 16 formatters in a row ought to be enough for everybody*/
-#define MAX_FORMATTERS_PER_OPERATION 16
+/* 16 formatters in a row ought to be enough for everybody, the transaction details start with
+ * one more per signer */
+#define MAX_FORMATTERS_PER_OPERATION (16 + SIGNERS_MAX_COUNT)
+
+/* screens of the current item kept rendered with HAVE_RENDERED_SCREENS, for paging back and
+ * forth without formatting, without it (Nano S) each screen is formatted when displayed */
+#define RENDERED_SCREENS_COUNT 4
 
 /* the current formatter */
 extern format_function_t formatter_stack[MAX_FORMATTERS_PER_OPERATION];
 /* the current details printed by the formatter */
 extern char op_caption[OPERATION_CAPTION_MAX_LENGTH];
 extern int8_t formatter_index;
+#ifdef TEST
+/* the review verbosity profile of the unit tests, read from the settings on the device */
+extern uint8_t verbosity_profile;
+#endif  // TEST
 
 void set_state_data(bool forward);
+
+/**
+ * Walk the whole review once, before it is displayed, to count the screens of the
+ * transaction details and of each operation.
+ *
+ * The counts are stored in G_context.tx_info and the formatter state is reset afterwards.
+ *
+ * @return true if the review could be walked to the last operation, false otherwise.
+ */
+bool count_screens(void);
+
+/**
+ * Render a screen of the transaction details, the ones before the operations, into
+ * G_ui_detail_caption and G_ui_detail_value. The formatter state is left on that screen.
+ *
+ * @return true if the screen was rendered, false if index is past the last screen of the
+ * transaction details, valid once count_screens() succeeded.
+ */
+bool render_tx_details_screen(uint8_t index);
+
+/**
+ * Position of the screen currently displayed in the whole review.
+ *
+ * @return index of the screen, starting at 0, valid once count_screens() succeeded.
+ */
+uint16_t get_screen_position(void);
+
+/**
+ * Forget the rendered screens, to be called before a new review.
+ */
+void reset_rendered_screens(void);
+
+/**
+ * Render the screen following the one displayed, while the user reads it, so that paging
+ * forward is a copy. The displayed screen and the formatter state are left untouched. Nothing
+ * is rendered ahead without HAVE_RENDERED_SCREENS.
+ *
+ * Formatting errors are raised as usual, the caller restores the displayed screen with
+ * set_state_data(true) after setting formatter_index back.
+ *
+ * @return true if a screen was rendered, false if there was nothing to render.
+ */
+bool prerender_next_screen(void);
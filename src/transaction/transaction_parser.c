@@ -23,6 +23,7 @@
 #include "./transaction_parser.h"
 #include "../types.h"
 #include "../sw.h"
+#include "../stats.h"
 #include "../common/buffer.h"
 
 #define PARSER_CHECK(x)         \
@@ -65,15 +66,6 @@ static bool buffer_read_bool(buffer_t *buffer, bool *b) {
     return true;
 }
 
-static bool buffer_read_bytes(buffer_t *buffer, uint8_t *out, size_t size) {
-    if (buffer->size - buffer->offset < size) {
-        return false;
-    }
-    memcpy(out, buffer->ptr + buffer->offset, size);
-    buffer->offset += size;
-    return true;
-}
-
 static size_t num_bytes(size_t size) {
     size_t remainder = size % 4;
     if (remainder == 0) {
@@ -449,16 +441,16 @@ bool parse_allow_trust(buffer_t *buffer, allow_trust_op_t *op) {
 
     PARSER_CHECK(parse_account_id(buffer, &op->trustor))
     PARSER_CHECK(buffer_read32(buffer, &asset_type))
+    op->asset_type = asset_type;
+    op->asset_code = (const char *) buffer->ptr + buffer->offset;
 
-    switch (asset_type) {
+    switch (op->asset_type) {
         case ASSET_TYPE_CREDIT_ALPHANUM4: {
-            PARSER_CHECK(buffer_read_bytes(buffer, (uint8_t *) op->asset_code, 4))
-            op->asset_code[4] = '\0';  // FIXME: it's OK?
+            PARSER_CHECK(buffer_advance(buffer, 4))
             break;
         }
         case ASSET_TYPE_CREDIT_ALPHANUM12: {
-            PARSER_CHECK(buffer_read_bytes(buffer, (uint8_t *) op->asset_code, 12))
-            op->asset_code[12] = '\0';
+            PARSER_CHECK(buffer_advance(buffer, 12))
             break;
         }
         default:
@@ -805,97 +797,45 @@ bool parse_liquidity_pool_withdraw(buffer_t *buffer, liquidity_pool_withdraw_op_
     return true;
 }
 
+typedef bool (*operation_parser_t)(buffer_t *, operation_t *);
+
+// Only the member of the operation type is cleared, the others are never read.
+#define OPERATION_PARSER(id, TYPE, name)                                             \
+    static bool parse_##name##_operation(buffer_t *buffer, operation_t *operation) { \
+        explicit_bzero(&operation->name##_op, sizeof(operation->name##_op));         \
+        return parse_##name(buffer, &operation->name##_op);                          \
+    }
+#define OPERATION_NO_BODY_PARSER(id, TYPE, name)                                     \
+    static bool parse_##name##_operation(buffer_t *buffer, operation_t *operation) { \
+        (void) buffer;                                                               \
+        (void) operation;                                                            \
+        return true;                                                                 \
+    }
+#define OPERATION_PARSERS_ENTRY(id, TYPE, name) [id] = &parse_##name##_operation,
+
+OPERATION_TYPES(OPERATION_PARSER, OPERATION_NO_BODY_PARSER)
+
+static const operation_parser_t operation_parsers[OPERATION_TYPES_COUNT] = {
+    OPERATION_TYPES(OPERATION_PARSERS_ENTRY, OPERATION_PARSERS_ENTRY)};
+
 bool parse_operation(buffer_t *buffer, operation_t *operation) {
-    explicit_bzero(operation, sizeof(operation_t));
+    explicit_bzero(&operation->source_account, sizeof(operation->source_account));
+    operation->source_account_present = false;
     uint32_t op_type;
 
+    STATS_INC(STATS_OPERATION_PARSES);
+
     PARSER_CHECK(parse_optional_type(buffer,
                                      (xdr_type_reader) parse_muxed_account,
                                      &operation->source_account,
                                      &operation->source_account_present))
 
     PARSER_CHECK(buffer_read32(buffer, &op_type))
-    operation->type = op_type;
-    switch (operation->type) {
-        case OPERATION_TYPE_CREATE_ACCOUNT: {
-            return parse_create_account(buffer, &operation->create_account_op);
-        }
-        case OPERATION_TYPE_PAYMENT: {
-            return parse_payment(buffer, &operation->payment_op);
-        }
-        case OPERATION_TYPE_PATH_PAYMENT_STRICT_RECEIVE: {
-            return parse_path_payment_strict_receive(buffer,
-                                                     &operation->path_payment_strict_receive_op);
-        }
-        case OPERATION_TYPE_CREATE_PASSIVE_SELL_OFFER: {
-            return parse_create_passive_sell_offer(buffer,
-                                                   &operation->create_passive_sell_offer_op);
-        }
-        case OPERATION_TYPE_MANAGE_SELL_OFFER: {
-            return parse_manage_sell_offer(buffer, &operation->manage_sell_offer_op);
-        }
-        case OPERATION_TYPE_SET_OPTIONS: {
-            return parse_set_options(buffer, &operation->set_options_op);
-        }
-        case OPERATION_TYPE_CHANGE_TRUST: {
-            return parse_change_trust(buffer, &operation->change_trust_op);
-        }
-        case OPERATION_TYPE_ALLOW_TRUST: {
-            return parse_allow_trust(buffer, &operation->allow_trust_op);
-        }
-        case OPERATION_TYPE_ACCOUNT_MERGE: {
-            return parse_account_merge(buffer, &operation->account_merge_op);
-        }
-        case OPERATION_TYPE_INFLATION: {
-            return true;
-        }
-        case OPERATION_TYPE_MANAGE_DATA: {
-            return parse_manage_data(buffer, &operation->manage_data_op);
-        }
-        case OPERATION_TYPE_BUMP_SEQUENCE: {
-            return parse_bump_sequence(buffer, &operation->bump_sequence_op);
-        }
-        case OPERATION_TYPE_MANAGE_BUY_OFFER: {
-            return parse_manage_buy_offer(buffer, &operation->manage_buy_offer_op);
-        }
-        case OPERATION_TYPE_PATH_PAYMENT_STRICT_SEND: {
-            return parse_path_payment_strict_send(buffer, &operation->path_payment_strict_send_op);
-        }
-        case OPERATION_TYPE_CREATE_CLAIMABLE_BALANCE: {
-            return parse_create_claimable_balance(buffer, &operation->create_claimable_balance_op);
-        }
-        case OPERATION_TYPE_CLAIM_CLAIMABLE_BALANCE: {
-            return parse_claim_claimable_balance(buffer, &operation->claim_claimable_balance_op);
-        }
-        case OPERATION_TYPE_BEGIN_SPONSORING_FUTURE_RESERVES: {
-            return parse_begin_sponsoring_future_reserves(
-                buffer,
-                &operation->begin_sponsoring_future_reserves_op);
-        }
-        case OPERATION_TYPE_END_SPONSORING_FUTURE_RESERVES: {
-            return true;
-        }
-        case OPERATION_TYPE_REVOKE_SPONSORSHIP: {
-            return parse_revoke_sponsorship(buffer, &operation->revoke_sponsorship_op);
-        }
-        case OPERATION_TYPE_CLAWBACK: {
-            return parse_clawback(buffer, &operation->clawback_op);
-        }
-        case OPERATION_TYPE_CLAWBACK_CLAIMABLE_BALANCE: {
-            return parse_clawback_claimable_balance(buffer,
-                                                    &operation->clawback_claimable_balance_op);
-        }
-        case OPERATION_TYPE_SET_TRUST_LINE_FLAGS: {
-            return parse_set_trust_line_flags(buffer, &operation->set_trust_line_flags_op);
-        }
-        case OPERATION_TYPE_LIQUIDITY_POOL_DEPOSIT:
-            return parse_liquidity_pool_deposit(buffer, &operation->liquidity_pool_deposit_op);
-        case OPERATION_TYPE_LIQUIDITY_POOL_WITHDRAW:
-            return parse_liquidity_pool_withdraw(buffer, &operation->liquidity_pool_withdraw_op);
-        default:
-            return false;
+    if (op_type >= OPERATION_TYPES_COUNT) {
+        return false;
     }
-    return false;
+    operation->type = op_type;
+    return ((operation_parser_t) PIC(operation_parsers[op_type]))(buffer, operation);
 }
 
 bool parse_transaction_source(buffer_t *buffer, muxed_account_t *source) {
@@ -961,6 +901,34 @@ bool parse_fee_bump_transaction_details(buffer_t *buffer,
     return true;
 }
 
+bool parse_transaction_ext(buffer_t *buffer) {
+    uint32_t ext;
+    PARSER_CHECK(buffer_read32(buffer, &ext))
+    if (ext != 0) {
+        return false;
+    }
+    return true;
+}
+
+bool parse_decorated_signature(buffer_t *buffer) {
+    const uint8_t *signature;
+    PARSER_CHECK(buffer_advance(buffer, SIGNATURE_HINT_SIZE))
+    PARSER_CHECK(parse_binary_string_ptr(buffer, &signature, NULL, SIGNATURE_SIZE))
+    return true;
+}
+
+bool parse_decorated_signatures(buffer_t *buffer) {
+    uint32_t length;
+    PARSER_CHECK(buffer_read32(buffer, &length))
+    if (length > DECORATED_SIGNATURES_MAX_LENGTH) {
+        return false;
+    }
+    for (uint32_t i = 0; i < length; i++) {
+        PARSER_CHECK(parse_decorated_signature(buffer))
+    }
+    return true;
+}
+
 bool parse_fee_bump_transaction_ext(buffer_t *buffer) {
     uint32_t ext;
     PARSER_CHECK(buffer_read32(buffer, &ext))
@@ -1001,10 +969,12 @@ bool parse_tx_xdr(const uint8_t *data, size_t size, tx_ctx_t *tx_ctx) {
 
     uint16_t offset = tx_ctx->offset;
     buffer.offset = tx_ctx->offset;
+    STATS_INC(STATS_TX_PARSES);
 
     if (offset == 0) {
         explicit_bzero(&tx_ctx->tx_details, sizeof(transaction_details_t));
         explicit_bzero(&tx_ctx->fee_bump_tx_details, sizeof(fee_bump_transaction_details_t));
+        explicit_bzero(tx_ctx->op_offsets, sizeof(tx_ctx->op_offsets));
         PARSER_CHECK(parse_network(&buffer, &tx_ctx->network))
         PARSER_CHECK(buffer_read32(&buffer, &envelope_type))
         tx_ctx->envelope_type = envelope_type;
@@ -1028,9 +998,79 @@ bool parse_tx_xdr(const uint8_t *data, size_t size, tx_ctx_t *tx_ctx) {
         }
     }
 
+    if (tx_ctx->tx_details.operation_index >= tx_ctx->tx_details.operations_count) {
+        return false;
+    }
+    tx_ctx->op_offsets[tx_ctx->tx_details.operation_index] = buffer.offset;
+
     PARSER_CHECK(parse_operation(&buffer, &tx_ctx->tx_details.op_details))
     offset = buffer.offset;
     tx_ctx->tx_details.operation_index += 1;
     tx_ctx->offset = offset;
     return true;
 }
+
+bool parse_tx_xdr_operation(const uint8_t *data, size_t size, tx_ctx_t *tx_ctx, uint8_t op_index) {
+    if (op_index >= tx_ctx->tx_details.operations_count) {
+        return false;
+    }
+    if (tx_ctx->tx_details.operation_index == op_index + 1) {
+        // already the current operation
+        return true;
+    }
+    if (tx_ctx->op_offsets[op_index] != 0) {
+        // offset already indexed, jump straight to it
+        tx_ctx->offset = tx_ctx->op_offsets[op_index];
+        tx_ctx->tx_details.operation_index = op_index;
+        return parse_tx_xdr(data, size, tx_ctx);
+    }
+    // not indexed yet, keep walking from the last parsed operation
+    while (tx_ctx->tx_details.operation_index <= op_index) {
+        PARSER_CHECK(parse_tx_xdr(data, size, tx_ctx))
+    }
+    return true;
+}
+
+// header and every operation, which also indexes the operation offsets, resuming after
+// the operations already parsed
+static bool parse_operations(const uint8_t *data, size_t size, tx_ctx_t *tx_ctx) {
+    if (tx_ctx->parsed_ops_count == 0) {
+        tx_ctx->offset = 0;
+        explicit_bzero(tx_ctx->op_type_counts, sizeof(tx_ctx->op_type_counts));
+    }
+    while (tx_ctx->parsed_ops_count == 0 ||
+           tx_ctx->parsed_ops_count < tx_ctx->tx_details.operations_count) {
+        PARSER_CHECK(parse_tx_xdr(data, size, tx_ctx))
+        tx_ctx->op_type_counts[tx_ctx->tx_details.op_details.type] += 1;
+        tx_ctx->parsed_ops_count += 1;
+    }
+    return true;
+}
+
+void parse_tx_xdr_prefix(const uint8_t *data, size_t size, tx_ctx_t *tx_ctx) {
+    // running out of data only means the next chunk is needed, validate_tx_xdr reports
+    // the errors once the whole envelope has been received
+    (void) parse_operations(data, size, tx_ctx);
+}
+
+bool validate_tx_xdr(const uint8_t *data, size_t size, tx_ctx_t *tx_ctx) {
+    bool parsed = parse_operations(data, size, tx_ctx);
+    // a new validation starts from the beginning of the envelope
+    tx_ctx->parsed_ops_count = 0;
+    PARSER_CHECK(parsed)
+
+    buffer_t buffer = {data, size, tx_ctx->offset};
+    PARSER_CHECK(parse_transaction_ext(&buffer))
+    if (tx_ctx->envelope_type == ENVELOPE_TYPE_TX_FEE_BUMP) {
+        // signatures of the inner transaction envelope
+        PARSER_CHECK(parse_decorated_signatures(&buffer))
+        PARSER_CHECK(parse_fee_bump_transaction_ext(&buffer))
+    }
+    // nothing may follow the envelope
+    if (buffer.offset != size) {
+        return false;
+    }
+
+    // leave the context on the first operation, as parse_tx_xdr does
+    return parse_tx_xdr_operation(data, size, tx_ctx, 0);
+}
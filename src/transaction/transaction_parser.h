@@ -2,3 +2,35 @@
 #include "../types.h"
 
 bool parse_tx_xdr(const uint8_t *data, size_t size, tx_ctx_t *tx_ctx);
+
+/**
+ * Parse the operation at op_index (0-based) into tx_ctx->tx_details.op_details.
+ *
+ * The envelope header must already have been parsed with parse_tx_xdr. Operations whose
+ * offset has been recorded in tx_ctx->op_offsets are parsed directly, without walking
+ * the envelope from the beginning again.
+ *
+ * @return true if success, false otherwise.
+ */
+bool parse_tx_xdr_operation(const uint8_t *data, size_t size, tx_ctx_t *tx_ctx, uint8_t op_index);
+
+/**
+ * Parse the operations fully contained in the first size bytes of an envelope still being
+ * received, resuming after the ones parsed by the previous call.
+ *
+ * Call it after each chunk with the whole data received so far, then validate_tx_xdr once
+ * the envelope is complete: it resumes from there instead of parsing everything again.
+ */
+void parse_tx_xdr_prefix(const uint8_t *data, size_t size, tx_ctx_t *tx_ctx);
+
+/**
+ * Parse the whole envelope once: header, every operation and the trailing extensions
+ * (and inner signatures of a fee bump transaction), without formatting anything.
+ *
+ * Operations already parsed by parse_tx_xdr_prefix are not parsed again. On success
+ * tx_ctx->op_offsets and tx_ctx->op_type_counts are filled, and the context is left on
+ * the first operation.
+ *
+ * @return true if the envelope is well-formed, false otherwise.
+ */
+bool validate_tx_xdr(const uint8_t *data, size_t size, tx_ctx_t *tx_ctx);
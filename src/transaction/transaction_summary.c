@@ -0,0 +1,263 @@
+/*****************************************************************************
+ *   Ledger Stellar App.
+ *   (c) 2022 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdbool.h>  // bool
+#include <string.h>   // memcmp, strlen
+
+#include "os.h"
+#include "bolos_target.h"
+
+#include "./transaction_summary.h"
+#include "./transaction_parser.h"
+#include "../sw.h"
+#include "../utils.h"
+
+#ifdef HAVE_TX_SUMMARY
+
+/* print_amount shows amounts below 10^12 units, a total past it can't be shown */
+#define SUMMARY_AMOUNT_LIMIT 10000000000000000000ULL
+
+#define SUMMARY_CHECK(x)                        \
+    {                                           \
+        if (!(x)) THROW(SW_TX_FORMATTING_FAIL); \
+    }
+
+static const char *const operation_names[OPERATION_TYPES_COUNT] = {
+    [OPERATION_TYPE_CREATE_ACCOUNT] = "Create Account",
+    [OPERATION_TYPE_PAYMENT] = "Payment",
+    [OPERATION_TYPE_PATH_PAYMENT_STRICT_RECEIVE] = "Path Payment Strict Receive",
+    [OPERATION_TYPE_MANAGE_SELL_OFFER] = "Manage Sell Offer",
+    [OPERATION_TYPE_CREATE_PASSIVE_SELL_OFFER] = "Create Passive Sell Offer",
+    [OPERATION_TYPE_SET_OPTIONS] = "Set Options",
+    [OPERATION_TYPE_CHANGE_TRUST] = "Change Trust",
+    [OPERATION_TYPE_ALLOW_TRUST] = "Allow Trust",
+    [OPERATION_TYPE_ACCOUNT_MERGE] = "Account Merge",
+    [OPERATION_TYPE_INFLATION] = "Inflation",
+    [OPERATION_TYPE_MANAGE_DATA] = "Manage Data",
+    [OPERATION_TYPE_BUMP_SEQUENCE] = "Bump Sequence",
+    [OPERATION_TYPE_MANAGE_BUY_OFFER] = "Manage Buy Offer",
+    [OPERATION_TYPE_PATH_PAYMENT_STRICT_SEND] = "Path Payment Strict Send",
+    [OPERATION_TYPE_CREATE_CLAIMABLE_BALANCE] = "Create Claimable Balance",
+    [OPERATION_TYPE_CLAIM_CLAIMABLE_BALANCE] = "Claim Claimable Balance",
+    [OPERATION_TYPE_BEGIN_SPONSORING_FUTURE_RESERVES] = "Begin Sponsoring Future Reserves",
+    [OPERATION_TYPE_END_SPONSORING_FUTURE_RESERVES] = "End Sponsoring Future Reserves",
+    [OPERATION_TYPE_REVOKE_SPONSORSHIP] = "Revoke Sponsorship",
+    [OPERATION_TYPE_CLAWBACK] = "Clawback",
+    [OPERATION_TYPE_CLAWBACK_CLAIMABLE_BALANCE] = "Clawback Claimable Balance",
+    [OPERATION_TYPE_SET_TRUST_LINE_FLAGS] = "Set Trust Line Flags",
+    [OPERATION_TYPE_LIQUIDITY_POOL_DEPOSIT] = "Liquidity Pool Deposit",
+    [OPERATION_TYPE_LIQUIDITY_POOL_WITHDRAW] = "Liquidity Pool Withdraw",
+};
+
+static bool same_asset(const asset_t *a, const asset_t *b) {
+    if (a->type != b->type) {
+        return false;
+    }
+    switch (a->type) {
+        case ASSET_TYPE_NATIVE:
+            return true;
+        case ASSET_TYPE_CREDIT_ALPHANUM4:
+            return memcmp(a->alpha_num4.asset_code, b->alpha_num4.asset_code, 4) == 0 &&
+                   memcmp(a->alpha_num4.issuer,
+                          b->alpha_num4.issuer,
+                          RAW_ED25519_PUBLIC_KEY_SIZE) == 0;
+        case ASSET_TYPE_CREDIT_ALPHANUM12:
+            return memcmp(a->alpha_num12.asset_code, b->alpha_num12.asset_code, 12) == 0 &&
+                   memcmp(a->alpha_num12.issuer,
+                          b->alpha_num12.issuer,
+                          RAW_ED25519_PUBLIC_KEY_SIZE) == 0;
+        default:
+            return false;
+    }
+}
+
+// Add an amount to the total of its asset, false past the capacity or the printable totals
+static bool add_amount(tx_summary_t *summary, const asset_t *asset, int64_t amount) {
+    uint8_t i = 0;
+
+    if (amount < 0) {
+        return false;
+    }
+    while (i < summary->assets_count && !same_asset(&summary->assets[i], asset)) {
+        i++;
+    }
+    if (i == SUMMARY_ASSETS_MAX_COUNT) {
+        return false;
+    }
+    if (i == summary->assets_count) {
+        summary->assets[i] = *asset;
+        summary->assets_count++;
+    }
+    if ((uint64_t) amount >= SUMMARY_AMOUNT_LIMIT - summary->totals[i]) {
+        return false;
+    }
+    summary->totals[i] += amount;
+    if ((uint64_t) amount > summary->largest[i]) {
+        summary->largest[i] = amount;
+    }
+    return true;
+}
+
+static bool same_muxed_account(const muxed_account_t *a, const muxed_account_t *b) {
+    if (a->type != b->type) {
+        return false;
+    }
+    if (a->type == KEY_TYPE_MUXED_ED25519) {
+        return a->med25519.id == b->med25519.id &&
+               memcmp(a->med25519.ed25519, b->med25519.ed25519, RAW_ED25519_PUBLIC_KEY_SIZE) == 0;
+    }
+    return memcmp(a->ed25519, b->ed25519, RAW_ED25519_PUBLIC_KEY_SIZE) == 0;
+}
+
+// Account a payment or an account creation sends to, false for the other operations
+static bool get_destination(const operation_t *op, muxed_account_t *destination) {
+    switch (op->type) {
+        case OPERATION_TYPE_PAYMENT:
+            *destination = op->payment_op.destination;
+            return true;
+        case OPERATION_TYPE_CREATE_ACCOUNT:
+            destination->type = KEY_TYPE_ED25519;
+            destination->ed25519 = op->create_account_op.destination;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Parse the operation recording a destination of the summary
+static bool parse_destination(tx_ctx_t *tx_ctx, uint8_t index, muxed_account_t *destination) {
+    return parse_tx_xdr_operation(tx_ctx->raw,
+                                  tx_ctx->raw_size,
+                                  tx_ctx,
+                                  tx_ctx->summary.destination_ops[index]) &&
+           get_destination(&tx_ctx->tx_details.op_details, destination);
+}
+
+// Record the operation at op_index unless an earlier operation sends to the same account
+static bool add_destination(tx_ctx_t *tx_ctx, uint8_t op_index) {
+    tx_summary_t *summary = &tx_ctx->summary;
+    muxed_account_t destination;
+    muxed_account_t recorded;
+
+    if (!get_destination(&tx_ctx->tx_details.op_details, &destination)) {
+        return false;
+    }
+    // the accounts point into the raw envelope, they stay valid across the parsing
+    for (uint8_t i = 0; i < summary->destinations_count; i++) {
+        if (!parse_destination(tx_ctx, i, &recorded)) {
+            return false;
+        }
+        if (same_muxed_account(&recorded, &destination)) {
+            return true;
+        }
+    }
+    summary->destination_ops[summary->destinations_count++] = op_index;
+    return true;
+}
+
+bool summarize_tx(tx_ctx_t *tx_ctx) {
+    tx_summary_t *summary = &tx_ctx->summary;
+
+    explicit_bzero(summary, sizeof(*summary));
+    for (uint8_t i = 0; i < tx_ctx->tx_details.operations_count; i++) {
+        if (!parse_tx_xdr_operation(tx_ctx->raw, tx_ctx->raw_size, tx_ctx, i)) {
+            return false;
+        }
+        const operation_t *op = &tx_ctx->tx_details.op_details;
+        // the summary only covers operations run by the source of the transaction
+        if (op->source_account_present &&
+            !same_muxed_account(&op->source_account, &tx_ctx->tx_details.source_account)) {
+            return false;
+        }
+        bool added;
+        if (op->type == OPERATION_TYPE_PAYMENT) {
+            added = add_amount(summary, &op->payment_op.asset, op->payment_op.amount);
+        } else if (op->type == OPERATION_TYPE_CREATE_ACCOUNT) {
+            asset_t native = {.type = ASSET_TYPE_NATIVE};
+            added = add_amount(summary, &native, op->create_account_op.starting_balance);
+        } else {
+            return false;
+        }
+        if (!added || !add_destination(tx_ctx, i)) {
+            return false;
+        }
+    }
+    // the review of the details starts from the first operation, as after validate_tx_xdr
+    return parse_tx_xdr_operation(tx_ctx->raw, tx_ctx->raw_size, tx_ctx, 0);
+}
+
+bool format_summary(tx_ctx_t *tx_ctx,
+                    uint8_t index,
+                    char *caption,
+                    size_t caption_len,
+                    char *value,
+                    size_t value_len) {
+    const tx_summary_t *summary = &tx_ctx->summary;
+    int screen = index;
+    size_t length;
+
+    if (screen == 0) {
+        SUMMARY_CHECK(strlcpy(caption, "Operations", caption_len) < caption_len)
+        SUMMARY_CHECK(print_uint(tx_ctx->tx_details.operations_count, value, value_len))
+        return true;
+    }
+    screen -= 1;
+    for (uint8_t type = 0; type < OPERATION_TYPES_COUNT; type++) {
+        if (tx_ctx->op_type_counts[type] == 0 || screen-- > 0) {
+            continue;
+        }
+        SUMMARY_CHECK(strlcpy(caption, "Operation Types", caption_len) < caption_len)
+        SUMMARY_CHECK(strlcpy(value, (const char *) PIC(operation_names[type]), value_len) <
+                      value_len)
+        SUMMARY_CHECK(strlcat(value, ": ", value_len) < value_len)
+        length = strlen(value);
+        SUMMARY_CHECK(
+            print_uint(tx_ctx->op_type_counts[type], value + length, value_len - length))
+        return true;
+    }
+    // two screens for each asset
+    if (screen < 2 * summary->assets_count) {
+        const asset_t *asset = &summary->assets[screen / 2];
+        bool total = screen % 2 == 0;
+        SUMMARY_CHECK(strlcpy(caption, total ? "Total Sent" : "Largest Amount", caption_len) <
+                      caption_len)
+        SUMMARY_CHECK(print_amount(total ? summary->totals[screen / 2]
+                                         : summary->largest[screen / 2],
+                                   asset,
+                                   tx_ctx->network,
+                                   value,
+                                   value_len))
+        return true;
+    }
+    screen -= 2 * summary->assets_count;
+    // then the full address of each destination
+    if (screen >= summary->destinations_count) {
+        return false;
+    }
+    muxed_account_t destination;
+    SUMMARY_CHECK(parse_destination(tx_ctx, screen, &destination))
+    SUMMARY_CHECK(strlcpy(caption, "Recipient ", caption_len) < caption_len)
+    length = strlen(caption);
+    SUMMARY_CHECK(print_uint(screen + 1, caption + length, caption_len - length))
+    SUMMARY_CHECK(strlcat(caption, " of ", caption_len) < caption_len)
+    length = strlen(caption);
+    SUMMARY_CHECK(print_uint(summary->destinations_count, caption + length, caption_len - length))
+    SUMMARY_CHECK(print_muxed_account(&destination, value, value_len, 0, 0))
+    return true;
+}
+
+#endif  // HAVE_TX_SUMMARY
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdbool.h>  // bool
+#include <stddef.h>   // size_t
+
+#include "../types.h"
+
+/*
+ * Transactions with at least this many operations are reviewed with their summary first, the
+ * user then chooses whether to page through the details of each operation.
+ */
+#define SUMMARY_MIN_OPERATIONS 10
+
+#ifdef HAVE_TX_SUMMARY
+/**
+ * Walk all the operations of a validated transaction once to aggregate its summary into
+ * tx_ctx->summary: total and largest amount sent in each asset and distinct destinations.
+ * The number of operations of each type is already counted by validate_tx_xdr.
+ *
+ * Only transactions whose operations are all payments and account creations run by the
+ * source of the transaction are summarized, the summary then shows everything they do.
+ *
+ * The context is left on the first operation.
+ *
+ * @return true if success, false if the transaction can't be summarized.
+ */
+bool summarize_tx(tx_ctx_t *tx_ctx);
+
+/**
+ * Print a screen of the summary computed by summarize_tx: number of operations, number of
+ * operations of each type present, total and largest amount sent in each asset, then the
+ * address of each destination. The operation of the last destination printed is left parsed.
+ *
+ * Formatting errors are raised with SW_TX_FORMATTING_FAIL.
+ *
+ * @return true if the screen was printed, false if index is past the last screen.
+ */
+bool format_summary(tx_ctx_t *tx_ctx,
+                    uint8_t index,
+                    char *caption,
+                    size_t caption_len,
+                    char *value,
+                    size_t value_len);
+#endif  // HAVE_TX_SUMMARY
@@ -27,13 +27,16 @@
 #define VERSION_BYTE_MUXED_ACCOUNT          12 << 3
 #define VERSION_BYTE_ED25519_SIGNED_PAYLOAD 15 << 3
 
-#define ASSET_CODE_MAX_LENGTH        13
 #define CLAIMANTS_MAX_LENGTH         10
 #define PATH_PAYMENT_MAX_PATH_LENGTH 5
 
 /* For sure not more than 35 operations will fit in that */
 #define MAX_OPS 35
 
+/* Maximum number of signatures of the inner transaction of a fee bump transaction */
+#define DECORATED_SIGNATURES_MAX_LENGTH 20
+#define SIGNATURE_HINT_SIZE             4
+
 /* max amount is max int64 scaled down: "922337203685.4775807" */
 #define AMOUNT_MAX_LENGTH 21
 
@@ -71,32 +74,45 @@ typedef enum {
     ENVELOPE_TYPE_TX_FEE_BUMP = 5,
 } envelope_type_t;
 
-typedef enum {
-    OPERATION_TYPE_CREATE_ACCOUNT = 0,
-    OPERATION_TYPE_PAYMENT = 1,
-    OPERATION_TYPE_PATH_PAYMENT_STRICT_RECEIVE = 2,
-    OPERATION_TYPE_MANAGE_SELL_OFFER = 3,
-    OPERATION_TYPE_CREATE_PASSIVE_SELL_OFFER = 4,
-    OPERATION_TYPE_SET_OPTIONS = 5,
-    OPERATION_TYPE_CHANGE_TRUST = 6,
-    OPERATION_TYPE_ALLOW_TRUST = 7,
-    OPERATION_TYPE_ACCOUNT_MERGE = 8,
-    OPERATION_TYPE_INFLATION = 9,
-    OPERATION_TYPE_MANAGE_DATA = 10,
-    OPERATION_TYPE_BUMP_SEQUENCE = 11,
-    OPERATION_TYPE_MANAGE_BUY_OFFER = 12,
-    OPERATION_TYPE_PATH_PAYMENT_STRICT_SEND = 13,
-    OPERATION_TYPE_CREATE_CLAIMABLE_BALANCE = 14,
-    OPERATION_TYPE_CLAIM_CLAIMABLE_BALANCE = 15,
-    OPERATION_TYPE_BEGIN_SPONSORING_FUTURE_RESERVES = 16,
-    OPERATION_TYPE_END_SPONSORING_FUTURE_RESERVES = 17,
-    OPERATION_TYPE_REVOKE_SPONSORSHIP = 18,
-    OPERATION_TYPE_CLAWBACK = 19,
-    OPERATION_TYPE_CLAWBACK_CLAIMABLE_BALANCE = 20,
-    OPERATION_TYPE_SET_TRUST_LINE_FLAGS = 21,
-    OPERATION_TYPE_LIQUIDITY_POOL_DEPOSIT = 22,
-    OPERATION_TYPE_LIQUIDITY_POOL_WITHDRAW = 23,
-} operation_type_t;
+/*
+ * Operation types known by the app, OP(type id, TYPE, name) for the operations with a body stored
+ * in the name##_op member of operation_t, OP_NO_BODY otherwise. The parser and the formatter expand
+ * it into their dispatch tables on parse_##name and format_##name, so supporting a new operation
+ * only needs a line here and these two functions.
+ */
+#define OPERATION_TYPES(OP, OP_NO_BODY)                                            \
+    OP(0, CREATE_ACCOUNT, create_account)                                          \
+    OP(1, PAYMENT, payment)                                                        \
+    OP(2, PATH_PAYMENT_STRICT_RECEIVE, path_payment_strict_receive)                \
+    OP(3, MANAGE_SELL_OFFER, manage_sell_offer)                                    \
+    OP(4, CREATE_PASSIVE_SELL_OFFER, create_passive_sell_offer)                    \
+    OP(5, SET_OPTIONS, set_options)                                                \
+    OP(6, CHANGE_TRUST, change_trust)                                              \
+    OP(7, ALLOW_TRUST, allow_trust)                                                \
+    OP(8, ACCOUNT_MERGE, account_merge)                                            \
+    OP_NO_BODY(9, INFLATION, inflation)                                            \
+    OP(10, MANAGE_DATA, manage_data)                                               \
+    OP(11, BUMP_SEQUENCE, bump_sequence)                                           \
+    OP(12, MANAGE_BUY_OFFER, manage_buy_offer)                                     \
+    OP(13, PATH_PAYMENT_STRICT_SEND, path_payment_strict_send)                     \
+    OP(14, CREATE_CLAIMABLE_BALANCE, create_claimable_balance)                     \
+    OP(15, CLAIM_CLAIMABLE_BALANCE, claim_claimable_balance)                       \
+    OP(16, BEGIN_SPONSORING_FUTURE_RESERVES, begin_sponsoring_future_reserves)     \
+    OP_NO_BODY(17, END_SPONSORING_FUTURE_RESERVES, end_sponsoring_future_reserves) \
+    OP(18, REVOKE_SPONSORSHIP, revoke_sponsorship)                                 \
+    OP(19, CLAWBACK, clawback)                                                     \
+    OP(20, CLAWBACK_CLAIMABLE_BALANCE, clawback_claimable_balance)                 \
+    OP(21, SET_TRUST_LINE_FLAGS, set_trust_line_flags)                             \
+    OP(22, LIQUIDITY_POOL_DEPOSIT, liquidity_pool_deposit)                         \
+    OP(23, LIQUIDITY_POOL_WITHDRAW, liquidity_pool_withdraw)
+
+#define OPERATION_TYPE_ENUM(id, TYPE, name) OPERATION_TYPE_##TYPE = id,
+#define OPERATION_TYPE_ONE(id, TYPE, name)  +1
+
+typedef enum { OPERATION_TYPES(OPERATION_TYPE_ENUM, OPERATION_TYPE_ENUM) } operation_type_t;
+
+/* Number of operation types known by the parser, their ids go from 0 to OPERATION_TYPES_COUNT-1 */
+#define OPERATION_TYPES_COUNT (0 OPERATION_TYPES(OPERATION_TYPE_ONE, OPERATION_TYPE_ONE))
 
 typedef const uint8_t *account_id_t;
 typedef int64_t sequence_number_t;
@@ -265,7 +281,8 @@ typedef struct {
 
 typedef struct {
     account_id_t trustor;
-    char asset_code[ASSET_CODE_MAX_LENGTH];
+    asset_type_t asset_type;  // ASSET_TYPE_CREDIT_ALPHANUM4 or ASSET_TYPE_CREDIT_ALPHANUM12
+    const char *asset_code;   // 4 or 12 bytes, padded with zeros
     // One of 0, AUTHORIZED_FLAG, or AUTHORIZED_TO_MAINTAIN_LIABILITIES_FLAG.
     uint32_t authorize;
 } allow_trust_op_t;
@@ -3,6 +3,8 @@
 #include <stddef.h>  // size_t
 #include <stdint.h>  // uint*_t
 
+#include "cx.h"  // cx_sha256_t
+
 #include "./common/bip32.h"
 #include "./transaction/transaction_types.h"
 
@@ -48,6 +50,56 @@
  */
 #define SIGNATURE_SIZE 64
 
+/**
+ * Maximum number of hashes signed by one INS_SIGN_TX_HASHES command, they are stored in the
+ * raw transaction buffer.
+ */
+#define HASHES_MAX_COUNT (RAW_TX_MAX_SIZE / HASH_SIZE)
+
+/**
+ * Number of signatures sent back in each INS_SIGN_TX_HASHES response.
+ */
+#define SIGNATURES_PER_RESPONSE 4
+
+/**
+ * Maximum number of BIP32 paths signing the transaction of one INS_SIGN_TX_SIGNERS command.
+ */
+#ifdef TARGET_NANOS
+#define SIGNERS_MAX_COUNT 3
+#else
+#define SIGNERS_MAX_COUNT 8
+#endif
+
+/**
+ * Maximum number of envelopes signed by one INS_SIGN_TX_BATCH command.
+ */
+#ifdef TARGET_NANOS
+#define BATCH_MAX_COUNT 4
+#else
+#define BATCH_MAX_COUNT 16
+#endif
+
+/**
+ * Maximum number of distinct assets sent by the envelopes of a batch.
+ */
+#define BATCH_ASSETS_MAX_COUNT 4
+
+/**
+ * Maximum number of distinct assets sent by a transaction reviewed with its summary.
+ */
+#define SUMMARY_ASSETS_MAX_COUNT 4
+
+/**
+ * Number of public keys sent back in each INS_GET_PUBLIC_KEYS response.
+ */
+#define PUBLIC_KEYS_PER_RESPONSE 8
+
+/**
+ * Number of StrKeys kept encoded while a transaction is reviewed, without HAVE_STRKEY_CACHE
+ * (Nano S) the keys of each screen are encoded again.
+ */
+#define STRKEY_CACHE_SIZE 8
+
 /**
  * Callback to reuse action with approve/reject in step FLOW.
  */
@@ -70,6 +122,11 @@ typedef enum {
     INS_SIGN_TX = 0x04,                // sign transaction with BIP32 path
     INS_GET_APP_CONFIGURATION = 0x06,  // app configuration of the application
     INS_SIGN_TX_HASH = 0x08,           // sign transaction in hash mode
+    INS_SIGN_TX_HASHES = 0x0A,         // sign a batch of transaction hashes
+    INS_GET_PUBLIC_KEYS = 0x0C,        // public keys of a range of BIP32 paths
+    INS_GET_STATS = 0x0E,              // performance counters, debug builds only
+    INS_SIGN_TX_SIGNERS = 0x10,        // sign transaction with several BIP32 paths
+    INS_SIGN_TX_BATCH = 0x12,          // sign a batch of transactions after one review
 } command_e;
 
 /**
@@ -80,7 +137,7 @@ typedef struct {
     command_e ins;  // Instruction code
     uint8_t p1;     // Instruction parameter 1
     uint8_t p2;     // Instruction parameter 2
-    uint8_t lc;     // Lenght of command data
+    uint16_t lc;    // Lenght of command data
     uint8_t *data;  // Command data
 } command_t;
 
@@ -88,43 +145,169 @@ typedef struct {
  * Enumeration with user request type.
  */
 typedef enum {
-    CONFIRM_ADDRESS,          // confirm address derived from public key
-    CONFIRM_TRANSACTION,      // confirm transaction information
-    CONFIRM_TRANSACTION_HASH  // confirm transaction hash information
+    CONFIRM_ADDRESS,              // confirm address derived from public key
+    CONFIRM_TRANSACTION,          // confirm transaction information
+    CONFIRM_TRANSACTION_SIGNERS,  // confirm transaction information for several paths
+    CONFIRM_TRANSACTION_HASH,     // confirm transaction hash information
+    CONFIRM_TRANSACTION_HASHES,   // confirm a batch of transaction hashes
+    CONFIRM_TRANSACTION_BATCH,    // confirm a batch of transactions
+    EXPORT_PUBLIC_KEYS            // export the public keys of a range of BIP32 paths
 } request_type_e;
 
 /**
  * Enumeration with parsing state.
  */
 typedef enum {
-    STATE_NONE,     // No state
-    STATE_PARSED,   // Transaction data parsed
-    STATE_APPROVED  // Transaction data approved
+    STATE_NONE,       // No state
+    STATE_RECEIVING,  // Chunks of the request being received
+    STATE_PARSED,     // Transaction data parsed
+    STATE_APPROVED    // Transaction data approved
 } state_e;
 
+#ifdef HAVE_STRKEY_CACHE
+/**
+ * Structure for a StrKey encoded from a 32 bytes key.
+ */
+typedef struct {
+    uint8_t version_byte;  // 0 if the entry is unused
+    uint8_t raw_key[RAW_ED25519_PUBLIC_KEY_SIZE];
+    char encoded[ENCODED_ED25519_PUBLIC_KEY_LENGTH - 1];  // without the terminator
+} strkey_cache_entry_t;
+
+/**
+ * Structure for the StrKeys encoded by the last screens, replaced in FIFO order.
+ */
+typedef struct {
+    strkey_cache_entry_t entries[STRKEY_CACHE_SIZE];
+    uint8_t next;  // entry replaced on the next miss
+} strkey_cache_t;
+#endif
+
+#ifdef HAVE_TX_SUMMARY
+/**
+ * Structure for the summary of a transaction, aggregated over all its payments and account
+ * creations. The assets point into the raw envelope.
+ */
+typedef struct {
+    asset_t assets[SUMMARY_ASSETS_MAX_COUNT];
+    uint64_t totals[SUMMARY_ASSETS_MAX_COUNT];   // total sent in each asset
+    uint64_t largest[SUMMARY_ASSETS_MAX_COUNT];  // largest amount sent at once in each asset
+    uint8_t destination_ops[MAX_OPS];  // first operation sending to each distinct destination
+    uint8_t assets_count;
+    uint8_t destinations_count;
+} tx_summary_t;
+#endif
+
+/**
+ * Structure for an account of a batch, copied out of its envelope.
+ */
+typedef struct {
+    crypto_key_type_t type;  // KEY_TYPE_ED25519 or KEY_TYPE_MUXED_ED25519
+    uint64_t id;             // muxed accounts only
+    uint8_t key[RAW_ED25519_PUBLIC_KEY_SIZE];
+} batch_account_t;
+
+/**
+ * Structure for the total sent in an asset by a batch.
+ */
+typedef struct {
+    asset_type_t type;
+    char code[12];  // zero padded, as in the envelope
+    uint8_t issuer[RAW_ED25519_PUBLIC_KEY_SIZE];
+    uint64_t total;
+} batch_asset_t;
+
+/**
+ * Structure for the summary of an envelope of a batch, which has a single operation.
+ */
+typedef struct {
+    uint32_t fee;
+    uint8_t asset_index;          // asset sent by the operation
+    uint64_t amount;              // amount sent by the operation
+    batch_account_t destination;  // destination of the operation
+    uint64_t max_time;            // upper time bound, 0 if unbounded
+} batch_envelope_t;
+
+/**
+ * Structure for a batch of envelopes, only their hashes and summaries are kept.
+ */
+typedef struct {
+    uint8_t hashes[BATCH_MAX_COUNT][HASH_SIZE];
+    batch_envelope_t envelopes[BATCH_MAX_COUNT];
+    batch_asset_t assets[BATCH_ASSETS_MAX_COUNT];
+    uint8_t assets_count;
+    uint8_t network;
+    batch_account_t source;  // source of all the envelopes
+    uint64_t fees;
+} batch_t;
+
+/**
+ * Maximum envelope size (bytes) in a batch, the summaries of the batch take the end of the
+ * raw transaction buffer.
+ */
+#define BATCH_ENVELOPE_MAX_SIZE ((RAW_TX_MAX_SIZE - sizeof(batch_t)) & ~7)
+
 /**
  * Structure for transaction context.
  *
  */
 typedef struct {
-    uint8_t raw[RAW_TX_MAX_SIZE];
+    union {
+        uint8_t raw[RAW_TX_MAX_SIZE];
+        struct {
+            uint8_t batch_envelope[BATCH_ENVELOPE_MAX_SIZE];
+            batch_t batch;
+        };
+    };
     uint32_t raw_size;
     uint16_t offset;
+    uint16_t op_offsets[MAX_OPS];  // start offset of each operation already parsed, 0 if unknown
+    uint8_t op_type_counts[OPERATION_TYPES_COUNT];  // number of operations per type
+    uint8_t parsed_ops_count;  // operations validated while the envelope was received
+    uint8_t screen_counts[MAX_OPS + 1];  // screens of the tx details, then of each operation
+    uint16_t screens_count;              // screens of the whole review
+#ifdef HAVE_STRKEY_CACHE
+    strkey_cache_t strkey_cache;  // keys encoded by the review, reset with the context
+#endif
+#ifdef HAVE_TX_SUMMARY
+    tx_summary_t summary;  // shown before the details of long transactions
+#endif
     uint8_t network;
     envelope_type_t envelope_type;
     fee_bump_transaction_details_t fee_bump_tx_details;
     transaction_details_t tx_details;
 } tx_ctx_t;
 
+/**
+ * Structure for a BIP32 path signing the transaction.
+ */
+typedef struct {
+    uint32_t bip32_path[MAX_BIP32_PATH];
+    uint8_t bip32_path_len;
+    uint8_t raw_public_key[RAW_ED25519_PUBLIC_KEY_SIZE];  // shown by the review
+} signing_path_t;
+
 /**
  * Structure for global context.
  */
 typedef struct {
     tx_ctx_t tx_info;                                     // tx
+    cx_sha256_t hash_ctx;                                 // tx hash of the chunks received
     uint8_t hash[HASH_SIZE];                              // tx hash
-    uint32_t bip32_path[MAX_BIP32_PATH];                  // BIP32 path
-    uint8_t raw_public_key[RAW_ED25519_PUBLIC_KEY_SIZE];  // BIP32 path public key
-    uint8_t bip32_path_len;                               // length of BIP32 path
+    uint16_t hashes_count;                                // hashes of the batch
+    uint16_t signed_hashes_count;                         // hashes of the batch already signed
+    uint32_t public_keys_index;                           // next index of the public keys range
+    uint8_t public_keys_count;                            // public keys of the range left to send
+    uint8_t signers_count;                                // 0 for INS_SIGN_TX
+    uint8_t signed_signers_count;                         // paths which already signed
+    union {
+        struct {
+            uint32_t bip32_path[MAX_BIP32_PATH];                  // BIP32 path
+            uint8_t raw_public_key[RAW_ED25519_PUBLIC_KEY_SIZE];  // BIP32 path public key
+            uint8_t bip32_path_len;                               // length of BIP32 path
+        };
+        signing_path_t signers[SIGNERS_MAX_COUNT];  // paths of INS_SIGN_TX_SIGNERS only
+    };
     state_e state;                                        // state of the context
     request_type_e req_type;                              // user request
 } global_ctx_t;
@@ -35,7 +35,10 @@ void ui_action_validate_pubkey(bool choice) {
 }
 
 void ui_action_validate_transaction(bool choice) {
-    if (choice) {
+    if (choice && G_context.signers_count > 0) {
+        G_context.state = STATE_APPROVED;
+        send_response_signers_sigs();
+    } else if (choice) {
         G_context.state = STATE_APPROVED;
         uint8_t signature[SIGNATURE_SIZE];
         if (crypto_sign_message(G_context.hash, sizeof(G_context.hash), signature, SIGNATURE_SIZE) <
@@ -51,3 +54,15 @@ void ui_action_validate_transaction(bool choice) {
     }
     ui_menu_main();
 };
+
+void ui_action_validate_transaction_hashes(bool choice) {
+    if (choice) {
+        G_context.state = STATE_APPROVED;
+        send_response_hashes_sigs();
+    } else {
+        // a rejected batch can't be continued or approved later
+        explicit_bzero(&G_context, sizeof(G_context));
+        io_send_sw(SW_DENY);
+    }
+    ui_menu_main();
+}
@@ -19,3 +19,12 @@ void ui_action_validate_pubkey(bool choice);
  *
  */
 void ui_action_validate_transaction(bool choice);
+
+/**
+ * Action for batch of transaction hashes validation, send the first signatures.
+ *
+ * @param[in] choice
+ *   User choice (either approved or rejected).
+ *
+ */
+void ui_action_validate_transaction_hashes(bool choice);
@@ -31,9 +31,22 @@ void ui_menu_main();
  */
 int ui_approve_tx_hash_init();
 
+/**
+ * Shows the summary of a batch of transactions to sign.
+ *
+ * @return 0 if success, negative integer otherwise.
+ *
+ */
+int ui_approve_tx_batch_init();
+
 /**
  * Shows the process of signing a transaction.
  *
  * @return 0 if success, negative integer otherwise.
  */
-int ui_approve_tx_init();
\ No newline at end of file
+int ui_approve_tx_init();
+
+/**
+ * Render the next screen of the transaction review in the background, called on ticker events.
+ */
+void ui_approve_tx_prerender();
@@ -23,9 +23,17 @@ void ui_idle(void);
 void display_settings(const ux_flow_step_t* const start_step);
 void switch_settings_hash_signing();
 void switch_settings_sequence_number();
+void switch_settings_verbosity();
+
+static const char* const VERBOSITY_NAMES[VERBOSITY_PROFILES_COUNT] = {"Full",
+                                                                      "Standard",
+                                                                      "Compact"};
+
 // FLOW for the settings menu:
 // #1 screen: enable hash signing
-// #2 screen: quit
+// #2 screen: display sequence number
+// #3 screen: review verbosity profile
+// #4 screen: quit
 #if defined(TARGET_NANOS)
 UX_STEP_CB(ux_settings_hash_signing_step,
            bnnn_paging,
@@ -41,6 +49,13 @@ UX_STEP_CB(ux_settings_sequence_number_step,
                .title = "Sequence Number",
                .text = G_ui_detail_value + 12,
            });
+UX_STEP_CB(ux_settings_verbosity_step,
+           bnnn_paging,
+           switch_settings_verbosity(),
+           {
+               .title = "Review Verbosity",
+               .text = G_ui_detail_value + 26,
+           });
 #else
 UX_STEP_CB(ux_settings_hash_signing_step,
            bnnn,
@@ -60,6 +75,15 @@ UX_STEP_CB(ux_settings_sequence_number_step,
                "in transactions",
                G_ui_detail_value + 12,
            });
+UX_STEP_CB(ux_settings_verbosity_step,
+           bnnn,
+           switch_settings_verbosity(),
+           {
+               "Review Verbosity",
+               "Redundant screens",
+               "in transactions",
+               G_ui_detail_value + 26,
+           });
 #endif
 UX_STEP_CB(ux_settings_exit_step,
            pb,
@@ -71,6 +95,7 @@ UX_STEP_CB(ux_settings_exit_step,
 UX_FLOW(ux_settings_flow,
         &ux_settings_hash_signing_step,
         &ux_settings_sequence_number_step,
+        &ux_settings_verbosity_step,
         &ux_settings_exit_step);
 
 // We have a screen with the icon and "Stellar is ready"
@@ -112,6 +137,11 @@ void display_settings(const ux_flow_step_t* const start_step) {
     strlcpy(G_ui_detail_value + 12,
             (HAS_SETTING(S_SEQUENCE_NUMBER_ENABLED) ? "Displayed" : "NOT Displayed"),
             14);
+    uint8_t verbosity = VERBOSITY_PROFILE();
+    strlcpy(G_ui_detail_value + 26,
+            verbosity < VERBOSITY_PROFILES_COUNT ? (const char*) PIC(VERBOSITY_NAMES[verbosity])
+                                                 : "Full",
+            10);
     ux_flow_init(0, ux_settings_flow, start_step);
 }
 
@@ -124,3 +154,11 @@ void switch_settings_sequence_number() {
     SETTING_TOGGLE(S_SEQUENCE_NUMBER_ENABLED);
     display_settings(&ux_settings_sequence_number_step);
 }
+
+void switch_settings_verbosity() {
+    uint8_t verbosity = VERBOSITY_PROFILE();
+    // Full, Standard, Compact, then Full again
+    SETTING_SET_VERBOSITY(verbosity + 1 < VERBOSITY_PROFILES_COUNT ? verbosity + 1
+                                                                   : VERBOSITY_FULL);
+    display_settings(&ux_settings_verbosity_step);
+}
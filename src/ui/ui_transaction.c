@@ -26,10 +26,18 @@
 #include "../io.h"
 #include "../transaction/transaction_parser.h"
 #include "../transaction/transaction_formatter.h"
-
-static uint8_t num_data;
+#include "../transaction/transaction_summary.h"
 
 static void display_next_state(bool is_upper_border);
+#ifdef HAVE_TX_SUMMARY
+static void display_summary_state(bool is_upper_border);
+static void ui_approve_tx_details(void);
+
+// the summary of a long transaction is displayed, instead of the details of its operations
+static bool summary_displayed;
+// screen of the summary displayed, starting at 1
+static int16_t summary_screen;
+#endif
 // clang-format off
 UX_STEP_NOCB(
     ux_confirm_tx_init_flow_step,
@@ -92,6 +100,56 @@ UX_FLOW(ux_confirm_flow,
   &ux_reject_tx_flow_step
 );
 
+#ifdef HAVE_TX_SUMMARY
+UX_STEP_INIT(
+    ux_summary_upper_border,
+    NULL,
+    NULL,
+    {
+        display_summary_state(true);
+    });
+UX_STEP_INIT(
+    ux_summary_lower_border,
+    NULL,
+    NULL,
+    {
+        display_summary_state(false);
+    });
+
+UX_STEP_CB(
+    ux_summary_details_step,
+    pnn,
+    ui_approve_tx_details(),
+    {
+      &C_icon_eye,
+      "Show",
+      "Details",
+    });
+
+UX_STEP_CB(
+    ux_summary_finalize_step,
+    pnn,
+    G_ui_validate_callback(true),
+    {
+      &C_icon_validate_14,
+      "Finalize",
+      "Without Details",
+    });
+
+// summary of a long transaction, then the choice to review its details or to skip them
+UX_FLOW(ux_summary_flow,
+  &ux_confirm_tx_init_flow_step,
+
+  &ux_summary_upper_border,
+  &ux_variable_display,
+  &ux_summary_lower_border,
+
+  &ux_summary_details_step,
+  &ux_summary_finalize_step,
+  &ux_reject_tx_flow_step
+);
+#endif
+
 
 static void display_next_state(bool is_upper_border) {
     PRINTF(
@@ -107,19 +165,15 @@ static void display_next_state(bool is_upper_border) {
             set_state_data(true);
             ux_flow_next();
         } else {
-            formatter_index -= 1;
-            if (G_ui_current_data_index > 0) {  // <- from middle, more screens available
+            if (get_screen_position() > 0) {  // <- from middle, more screens available
+                formatter_index -= 1;
                 set_state_data(false);
-                if (formatter_stack[formatter_index] != NULL) {
-                    ux_flow_next();
-                } else {
-                    G_ui_current_state = OUT_OF_BORDERS;
-                    G_ui_current_data_index = 0;
-                    ux_flow_prev();
-                }
+                ux_flow_next();
             } else {  // <- from middle, no more screens available
                 G_ui_current_state = OUT_OF_BORDERS;
                 G_ui_current_data_index = 0;
+                formatter_index = 0;
+                explicit_bzero(formatter_stack, sizeof(formatter_stack));
                 ux_flow_prev();
             }
         }
@@ -130,9 +184,8 @@ static void display_next_state(bool is_upper_border) {
             set_state_data(false);
             ux_flow_prev();
         } else {
-            if ((num_data != 0 && G_ui_current_data_index < num_data - 1) ||
-                formatter_stack[formatter_index + 1] !=
-                    NULL) {  // -> from middle, more screens available
+            if (get_screen_position() + 1 <
+                G_context.tx_info.screens_count) {  // -> from middle, more screens available
                 formatter_index += 1;
                 set_state_data(true);
                 /*dirty hack to have coherent behavior on bnnn_paging when there are multiple
@@ -150,20 +203,135 @@ static void display_next_state(bool is_upper_border) {
     }
 }
 
+#ifdef HAVE_TX_SUMMARY
+static bool get_next_summary_data(bool forward) {
+    uint8_t tx_screens = G_context.tx_info.screen_counts[0];
 
-int ui_approve_tx_init(void) {
-    if (G_context.req_type != CONFIRM_TRANSACTION || G_context.state != STATE_PARSED) {
-        G_context.state = STATE_NONE;
-        return io_send_sw(SW_BAD_STATE);
+    if (forward) {
+        summary_screen++;
+    } else {
+        summary_screen--;
+    }
+    if (summary_screen < 1) {
+        return false;
     }
+    // the transaction details are shown as in the review, then the summary of the operations
+    if (summary_screen <= tx_screens) {
+        return render_tx_details_screen(summary_screen - 1);
+    }
+    return format_summary(&G_context.tx_info,
+                          summary_screen - 1 - tx_screens,
+                          G_ui_detail_caption,
+                          DETAIL_CAPTION_MAX_LENGTH,
+                          G_ui_detail_value,
+                          DETAIL_VALUE_MAX_LENGTH);
+}
+
+// Same walk through the dynamic screens as the review of a transaction hash.
+static void display_summary_state(bool is_upper_border) {
+    if (is_upper_border) {
+        if (G_ui_current_state == OUT_OF_BORDERS) {
+            if (get_next_summary_data(true)) {
+                G_ui_current_state = INSIDE_BORDERS;
+            }
+            ux_flow_next();
+        } else {
+            if (get_next_summary_data(false)) {
+                ux_flow_next();
+            } else {
+                G_ui_current_state = OUT_OF_BORDERS;
+                ux_flow_prev();
+            }
+        }
+    } else {
+        if (G_ui_current_state == OUT_OF_BORDERS) {
+            if (get_next_summary_data(false)) {
+                G_ui_current_state = INSIDE_BORDERS;
+            }
+            ux_flow_prev();
+        } else {
+            if (get_next_summary_data(true)) {
+                /*same hack as in display_next_state*/
+                G_ux.flow_stack[G_ux.stack_count - 1].prev_index =
+                    G_ux.flow_stack[G_ux.stack_count - 1].index - 2;
+                G_ux.flow_stack[G_ux.stack_count - 1].index--;
+                ux_flow_relayout();
+            } else {
+                G_ui_current_state = OUT_OF_BORDERS;
+                ux_flow_next();
+            }
+        }
+    }
+}
+#endif
+
+static void reset_review_state(void) {
     G_ui_current_data_index = 0;
     G_ui_current_state = OUT_OF_BORDERS;
-    G_context.tx_info.offset = 0;
     formatter_index = 0;
-
     explicit_bzero(formatter_stack, sizeof(formatter_stack));
-    num_data = G_context.tx_info.tx_details.operations_count;
+}
+
+#ifdef HAVE_TX_SUMMARY
+// The user chose to review the details after the summary, they start at the first screen
+static void ui_approve_tx_details(void) {
+    summary_displayed = false;
+    reset_review_state();
+    ux_flow_init(0, ux_confirm_flow, &ux_init_upper_border);
+}
+#endif
+
+int ui_approve_tx_init(void) {
+    if ((G_context.req_type != CONFIRM_TRANSACTION &&
+         G_context.req_type != CONFIRM_TRANSACTION_SIGNERS) ||
+        G_context.state != STATE_PARSED) {
+        G_context.state = STATE_NONE;
+        return io_send_sw(SW_BAD_STATE);
+    }
+    // the screen counts let the review know where it stands without probing the formatters
+    if (!count_screens()) {
+        G_context.state = STATE_NONE;
+        return io_send_sw(SW_TX_FORMATTING_FAIL);
+    }
     G_ui_validate_callback = &ui_action_validate_transaction;
+    reset_review_state();
+#ifdef HAVE_TX_SUMMARY
+    // a long transaction is summarized first, its details are only shown if the user asks
+    summary_displayed = G_context.tx_info.tx_details.operations_count >= SUMMARY_MIN_OPERATIONS &&
+                        summarize_tx(&G_context.tx_info);
+    summary_screen = 0;
+    ux_flow_init(0, summary_displayed ? ux_summary_flow : ux_confirm_flow, NULL);
+#else
+    // Nano S always shows the details
     ux_flow_init(0, ux_confirm_flow, NULL);
+#endif
     return 0;
-}
\ No newline at end of file
+}
+
+void ui_approve_tx_prerender() {
+    if ((G_context.req_type != CONFIRM_TRANSACTION &&
+         G_context.req_type != CONFIRM_TRANSACTION_SIGNERS) ||
+        G_context.state != STATE_PARSED || G_ui_current_state != INSIDE_BORDERS) {
+        return;
+    }
+#ifdef HAVE_TX_SUMMARY
+    if (summary_displayed) {
+        return;
+    }
+#endif
+    int8_t index = formatter_index;
+    BEGIN_TRY {
+        TRY {
+            prerender_next_screen();
+        }
+        CATCH_OTHER(e) {
+            (void) e;
+            // the error is raised again if the user pages to that screen, restore this one
+            formatter_index = index;
+            set_state_data(true);
+        }
+        FINALLY {
+        }
+    }
+    END_TRY;
+}
@@ -0,0 +1,246 @@
+/*****************************************************************************
+ *   Ledger Stellar App.
+ *   (c) 2022 Ledger SAS.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************/
+
+#include <stdbool.h>  // bool
+#include <string.h>   // strlen
+
+#include "./ui.h"
+#include "./action/validate.h"
+#include "../globals.h"
+#include "../sw.h"
+#include "../utils.h"
+#include "../io.h"
+
+static void display_next_state(bool is_upper_delimiter);
+
+// Step with icon and text
+UX_STEP_NOCB(ux_tx_batch_review_step,
+             pnn,
+             {
+                 &C_icon_eye,
+                 "Review",
+                 "Transactions",
+             });
+UX_STEP_INIT(ux_tx_batch_init_upper_border, NULL, NULL, { display_next_state(true); });
+UX_STEP_NOCB(ux_tx_batch_variable_display,
+             bnnn_paging,
+             {
+                 .title = G_ui_detail_caption,
+                 .text = G_ui_detail_value,
+             });
+UX_STEP_INIT(ux_tx_batch_init_lower_border, NULL, NULL, { display_next_state(false); });
+// Step with approve button
+UX_STEP_CB(ux_tx_batch_approve_step,
+           pb,
+           (*G_ui_validate_callback)(true),
+           {
+               &C_icon_validate_14,
+               "Approve",
+           });
+// Step with reject button
+UX_STEP_CB(ux_tx_batch_reject_step,
+           pb,
+           (*G_ui_validate_callback)(false),
+           {
+               &C_icon_crossmark,
+               "Reject",
+           });
+// FLOW to display a batch of transactions
+// #1 screen: eye icon + "Review Transactions"
+// #2 screen: number of transactions, network, source and total fees
+// #3 screen: total sent in each asset
+// #4 screen: summary of each transaction
+// #5 screen: approve button
+// #6 screen: reject button
+UX_FLOW(ux_tx_batch_flow,
+        &ux_tx_batch_review_step,
+        &ux_tx_batch_init_upper_border,
+        &ux_tx_batch_variable_display,
+        &ux_tx_batch_init_lower_border,
+        &ux_tx_batch_approve_step,
+        &ux_tx_batch_reject_step);
+
+static bool print_batch_account(const batch_account_t *account,
+                                char *out,
+                                size_t out_len,
+                                uint8_t num_chars_l,
+                                uint8_t num_chars_r) {
+    muxed_account_t muxed_account = {.type = account->type};
+    if (account->type == KEY_TYPE_MUXED_ED25519) {
+        muxed_account.med25519.id = account->id;
+        muxed_account.med25519.ed25519 = account->key;
+    } else {
+        muxed_account.ed25519 = account->key;
+    }
+    return print_muxed_account(&muxed_account, out, out_len, num_chars_l, num_chars_r);
+}
+
+static bool print_batch_amount(uint64_t amount,
+                               const batch_asset_t *batch_asset,
+                               char *out,
+                               size_t out_len) {
+    asset_t asset = {.type = batch_asset->type};
+    // both credit assets have the same layout
+    asset.alpha_num4.asset_code = batch_asset->code;
+    asset.alpha_num4.issuer = batch_asset->issuer;
+    return print_amount(amount, &asset, G_context.tx_info.batch.network, out, out_len);
+}
+
+// Summary of a transaction: what its operation sends and to whom
+static bool print_batch_envelope(const batch_envelope_t *envelope, char *out, size_t out_len) {
+    const batch_t *batch = &G_context.tx_info.batch;
+    const batch_asset_t *asset = &batch->assets[envelope->asset_index];
+    if (!print_batch_amount(envelope->amount, asset, out, out_len) ||
+        strlcat(out, " to ", out_len) >= out_len) {
+        return false;
+    }
+    size_t length = strlen(out);
+    return print_batch_account(&envelope->destination, out + length, out_len - length, 6, 6);
+}
+
+// Caption of a transaction of the batch, "Tx i" followed by the suffix
+static bool print_tx_caption(char *caption, uint8_t tx_index, const char *suffix) {
+    if (strlcpy(caption, "Tx ", DETAIL_CAPTION_MAX_LENGTH) >= DETAIL_CAPTION_MAX_LENGTH) {
+        return false;
+    }
+    size_t length = strlen(caption);
+    return print_uint(tx_index + 1, caption + length, DETAIL_CAPTION_MAX_LENGTH - length) &&
+           strlcat(caption, suffix, DETAIL_CAPTION_MAX_LENGTH) < DETAIL_CAPTION_MAX_LENGTH;
+}
+
+static bool get_next_data(char *caption, char *value, bool forward) {
+    const batch_t *batch = &G_context.tx_info.batch;
+    bool printed;
+
+    if (forward) {
+        G_ui_current_data_index++;
+    } else {
+        G_ui_current_data_index--;
+    }
+    // screens of the whole batch, then of each asset, then of each transaction
+    int index = G_ui_current_data_index - 1;
+    if (index < 0) {
+        return false;
+    }
+    if (index == 0) {
+        strlcpy(caption, "Transactions", DETAIL_CAPTION_MAX_LENGTH);
+        printed = print_uint(G_context.hashes_count, value, DETAIL_VALUE_MAX_LENGTH);
+    } else if (index == 1) {
+        strlcpy(caption, "Network", DETAIL_CAPTION_MAX_LENGTH);
+        printed = strlcpy(value,
+                          batch->network == NETWORK_TYPE_PUBLIC  ? "Public"
+                          : batch->network == NETWORK_TYPE_TEST ? "Testnet"
+                                                                : "Unknown",
+                          DETAIL_VALUE_MAX_LENGTH) < DETAIL_VALUE_MAX_LENGTH;
+    } else if (index == 2) {
+        strlcpy(caption, "Tx Source", DETAIL_CAPTION_MAX_LENGTH);
+        printed = print_batch_account(&batch->source, value, DETAIL_VALUE_MAX_LENGTH, 0, 0);
+    } else if (index == 3) {
+        strlcpy(caption, "Total Fees", DETAIL_CAPTION_MAX_LENGTH);
+        batch_asset_t native = {.type = ASSET_TYPE_NATIVE};
+        printed = print_batch_amount(batch->fees, &native, value, DETAIL_VALUE_MAX_LENGTH);
+    } else if (index - 4 < batch->assets_count) {
+        strlcpy(caption, "Total Sent", DETAIL_CAPTION_MAX_LENGTH);
+        const batch_asset_t *asset = &batch->assets[index - 4];
+        printed = print_batch_amount(asset->total, asset, value, DETAIL_VALUE_MAX_LENGTH);
+    } else {
+        // one screen of each transaction, then one of its upper time bound if it has one
+        index -= 4 + batch->assets_count;
+        uint8_t i = 0;
+        while (i < G_context.hashes_count && index > (batch->envelopes[i].max_time != 0)) {
+            index -= 1 + (batch->envelopes[i].max_time != 0);
+            i++;
+        }
+        if (i == G_context.hashes_count) {
+            return false;
+        }
+        const batch_envelope_t *envelope = &batch->envelopes[i];
+        if (index == 0) {
+            printed = print_tx_caption(caption, i, " of ");
+            if (printed) {
+                size_t length = strlen(caption);
+                printed = print_uint(G_context.hashes_count,
+                                     caption + length,
+                                     DETAIL_CAPTION_MAX_LENGTH - length) &&
+                          print_batch_envelope(envelope, value, DETAIL_VALUE_MAX_LENGTH);
+            }
+        } else {
+            printed = print_tx_caption(caption, i, " Valid Before") &&
+                      print_time(envelope->max_time, value, DETAIL_VALUE_MAX_LENGTH);
+        }
+    }
+    if (!printed) {
+        THROW(SW_TX_FORMATTING_FAIL);
+    }
+    return true;
+}
+
+// This is a special function you must call for bnnn_paging to work properly in an edgecase.
+// It does some weird stuff with the `G_ux` global which is defined by the SDK.
+// No need to dig deeper into the code, a simple copy-paste will do.
+static void bnnn_paging_edgecase() {
+    G_ux.flow_stack[G_ux.stack_count - 1].prev_index =
+        G_ux.flow_stack[G_ux.stack_count - 1].index - 2;
+    G_ux.flow_stack[G_ux.stack_count - 1].index--;
+    ux_flow_relayout();
+}
+
+// Same walk through the dynamic screens as the review of a transaction hash.
+static void display_next_state(bool is_upper_delimiter) {
+    if (is_upper_delimiter) {
+        if (G_ui_current_state == OUT_OF_BORDERS) {
+            if (get_next_data(G_ui_detail_caption, G_ui_detail_value, true)) {
+                G_ui_current_state = INSIDE_BORDERS;
+            }
+            ux_flow_next();
+        } else {
+            if (get_next_data(G_ui_detail_caption, G_ui_detail_value, false)) {
+                ux_flow_next();
+            } else {
+                G_ui_current_state = OUT_OF_BORDERS;
+                ux_flow_prev();
+            }
+        }
+    } else {
+        if (G_ui_current_state == OUT_OF_BORDERS) {
+            if (get_next_data(G_ui_detail_caption, G_ui_detail_value, false)) {
+                G_ui_current_state = INSIDE_BORDERS;
+            }
+            ux_flow_prev();
+        } else {
+            if (get_next_data(G_ui_detail_caption, G_ui_detail_value, true)) {
+                bnnn_paging_edgecase();
+            } else {
+                G_ui_current_state = OUT_OF_BORDERS;
+                ux_flow_next();
+            }
+        }
+    }
+}
+
+int ui_approve_tx_batch_init() {
+    if (G_context.req_type != CONFIRM_TRANSACTION_BATCH || G_context.state != STATE_PARSED) {
+        G_context.state = STATE_NONE;
+        return io_send_sw(SW_BAD_STATE);
+    }
+    G_ui_current_state = OUT_OF_BORDERS;
+    G_ui_current_data_index = 0;
+    // signed as a batch of hashes
+    G_ui_validate_callback = &ui_action_validate_transaction_hashes;
+    ux_flow_init(0, ux_tx_batch_flow, NULL);
+    return 0;
+}
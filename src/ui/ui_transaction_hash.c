@@ -72,7 +72,7 @@ UX_STEP_CB(ux_tx_hash_display_reject_step,
 // #1 screen: eye icon + "Review Transaction"
 // #1 screen: warning icon + "Hash Signing"
 // #2 screen: display address
-// #3 screen: display hash
+// #3 screen: display hash, or number of hashes and their digest for a batch
 // #4 screen: approve button
 // #5 screen: reject button
 UX_FLOW(ux_tx_hash_signing_flow,
@@ -100,11 +100,28 @@ static bool get_next_data(char *caption, char *value, bool forward) {
             }
             break;
         case 2:
+            if (G_context.req_type == CONFIRM_TRANSACTION_HASHES) {
+                strlcpy(caption, "Hashes", DETAIL_CAPTION_MAX_LENGTH);
+                if (!print_uint(G_context.hashes_count, value, DETAIL_VALUE_MAX_LENGTH)) {
+                    return io_send_sw(SW_DISPLAY_TRANSACTION_HASH_FAIL);
+                }
+                break;
+            }
             strlcpy(caption, "Hash", DETAIL_CAPTION_MAX_LENGTH);
             if (!format_hex(G_context.hash, 32, value, DETAIL_VALUE_MAX_LENGTH)) {
                 return io_send_sw(SW_DISPLAY_TRANSACTION_HASH_FAIL);
             }
             break;
+        case 3:
+            if (G_context.req_type != CONFIRM_TRANSACTION_HASHES) {
+                return false;
+            }
+            // SHA-256 of all the hashes of the batch, to be compared with the host's
+            strlcpy(caption, "Digest", DETAIL_CAPTION_MAX_LENGTH);
+            if (!format_hex(G_context.hash, 32, value, DETAIL_VALUE_MAX_LENGTH)) {
+                return io_send_sw(SW_DISPLAY_TRANSACTION_HASH_FAIL);
+            }
+            break;
         default:
             return false;
     }
@@ -189,13 +206,19 @@ static void display_next_state(bool is_upper_delimiter) {
 }
 
 int ui_approve_tx_hash_init() {
-    if (G_context.req_type != CONFIRM_TRANSACTION_HASH || G_context.state != STATE_NONE) {
+    // a batch of hashes is reviewed once all of them are received
+    if ((G_context.req_type != CONFIRM_TRANSACTION_HASH || G_context.state != STATE_NONE) &&
+        (G_context.req_type != CONFIRM_TRANSACTION_HASHES || G_context.state != STATE_PARSED)) {
         G_context.state = STATE_NONE;
         return io_send_sw(SW_BAD_STATE);
     }
     G_ui_current_state = OUT_OF_BORDERS;
     G_ui_current_data_index = 0;
-    G_ui_validate_callback = &ui_action_validate_transaction;
+    if (G_context.req_type == CONFIRM_TRANSACTION_HASHES) {
+        G_ui_validate_callback = &ui_action_validate_transaction_hashes;
+    } else {
+        G_ui_validate_callback = &ui_action_validate_transaction;
+    }
     ux_flow_init(0, ux_tx_hash_signing_flow, NULL);
     return 0;
 }
\ No newline at end of file
@@ -15,12 +15,11 @@
  *  limitations under the License.
  *****************************************************************************/
 
-#include <stdio.h>
 #include <string.h>
-#include <time.h>
 #include <bolos_target.h>
 
 #include "./utils.h"
+#include "./stats.h"
 #include "./common/base32.h"
 #include "./common/base58.h"
 #include "./common/format.h"
@@ -60,26 +59,90 @@ bool base64_encode(const uint8_t *data, size_t in_len, char *out, size_t out_len
     return true;
 }
 
+#ifdef CRC16_BYTE_TABLE
+/* CRC16-XModem of every byte value, 512 bytes of flash */
+static const uint16_t CRC16_TABLE[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+    0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52b5, 0x4294, 0x72f7, 0x62d6,
+    0x9339, 0x8318, 0xb37b, 0xa35a, 0xd3bd, 0xc39c, 0xf3ff, 0xe3de,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64e6, 0x74c7, 0x44a4, 0x5485,
+    0xa56a, 0xb54b, 0x8528, 0x9509, 0xe5ee, 0xf5cf, 0xc5ac, 0xd58d,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76d7, 0x66f6, 0x5695, 0x46b4,
+    0xb75b, 0xa77a, 0x9719, 0x8738, 0xf7df, 0xe7fe, 0xd79d, 0xc7bc,
+    0x48c4, 0x58e5, 0x6886, 0x78a7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xc9cc, 0xd9ed, 0xe98e, 0xf9af, 0x8948, 0x9969, 0xa90a, 0xb92b,
+    0x5af5, 0x4ad4, 0x7ab7, 0x6a96, 0x1a71, 0x0a50, 0x3a33, 0x2a12,
+    0xdbfd, 0xcbdc, 0xfbbf, 0xeb9e, 0x9b79, 0x8b58, 0xbb3b, 0xab1a,
+    0x6ca6, 0x7c87, 0x4ce4, 0x5cc5, 0x2c22, 0x3c03, 0x0c60, 0x1c41,
+    0xedae, 0xfd8f, 0xcdec, 0xddcd, 0xad2a, 0xbd0b, 0x8d68, 0x9d49,
+    0x7e97, 0x6eb6, 0x5ed5, 0x4ef4, 0x3e13, 0x2e32, 0x1e51, 0x0e70,
+    0xff9f, 0xefbe, 0xdfdd, 0xcffc, 0xbf1b, 0xaf3a, 0x9f59, 0x8f78,
+    0x9188, 0x81a9, 0xb1ca, 0xa1eb, 0xd10c, 0xc12d, 0xf14e, 0xe16f,
+    0x1080, 0x00a1, 0x30c2, 0x20e3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83b9, 0x9398, 0xa3fb, 0xb3da, 0xc33d, 0xd31c, 0xe37f, 0xf35e,
+    0x02b1, 0x1290, 0x22f3, 0x32d2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xb5ea, 0xa5cb, 0x95a8, 0x8589, 0xf56e, 0xe54f, 0xd52c, 0xc50d,
+    0x34e2, 0x24c3, 0x14a0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xa7db, 0xb7fa, 0x8799, 0x97b8, 0xe75f, 0xf77e, 0xc71d, 0xd73c,
+    0x26d3, 0x36f2, 0x0691, 0x16b0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xd94c, 0xc96d, 0xf90e, 0xe92f, 0x99c8, 0x89e9, 0xb98a, 0xa9ab,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18c0, 0x08e1, 0x3882, 0x28a3,
+    0xcb7d, 0xdb5c, 0xeb3f, 0xfb1e, 0x8bf9, 0x9bd8, 0xabbb, 0xbb9a,
+    0x4a75, 0x5a54, 0x6a37, 0x7a16, 0x0af1, 0x1ad0, 0x2ab3, 0x3a92,
+    0xfd2e, 0xed0f, 0xdd6c, 0xcd4d, 0xbdaa, 0xad8b, 0x9de8, 0x8dc9,
+    0x7c26, 0x6c07, 0x5c64, 0x4c45, 0x3ca2, 0x2c83, 0x1ce0, 0x0cc1,
+    0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8,
+    0x6e17, 0x7e36, 0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0};
+
+uint16_t crc16(const uint8_t *input_str, int num_bytes) {
+    uint16_t crc = 0;
+    while (--num_bytes >= 0) {
+        crc = crc << 8 ^ CRC16_TABLE[(crc >> 8 ^ *input_str++) & 0xFF];
+    }
+    return crc;
+}
+#else
+/* CRC16-XModem of every nibble value, one lookup per 4 bits */
+static const uint16_t CRC16_NIBBLE_TABLE[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+    0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef};
+
 uint16_t crc16(const uint8_t *input_str, int num_bytes) {
-    uint16_t crc;
-    crc = 0;
+    uint16_t crc = 0;
     while (--num_bytes >= 0) {
-        crc = crc ^ (uint32_t) *input_str++ << 8;
-        int i = 8;
-        do {
-            if (crc & 0x8000)
-                crc = crc << 1 ^ 0x1021;
-            else
-                crc = crc << 1;
-        } while (--i);
+        crc = crc << 4 ^ CRC16_NIBBLE_TABLE[(crc >> 12) ^ (*input_str >> 4)];
+        crc = crc << 4 ^ CRC16_NIBBLE_TABLE[(crc >> 12) ^ (*input_str++ & 0x0F)];
     }
     return crc;
 }
+#endif
+
+#ifdef HAVE_STRKEY_CACHE
+static strkey_cache_t *strkey_cache;
+
+void set_strkey_cache(strkey_cache_t *cache) {
+    strkey_cache = cache;
+}
+#endif
 
 bool encode_key(const uint8_t *in, uint8_t version_byte, char *out, uint8_t out_len) {
     if (out_len < 56 + 1) {
         return false;
     }
+#ifdef HAVE_STRKEY_CACHE
+    if (strkey_cache != NULL) {
+        for (uint8_t i = 0; i < STRKEY_CACHE_SIZE; i++) {
+            const strkey_cache_entry_t *entry = &strkey_cache->entries[i];
+            if (entry->version_byte == version_byte && memcmp(entry->raw_key, in, 32) == 0) {
+                memcpy(out, entry->encoded, 56);
+                out[56] = '\0';
+                return true;
+            }
+        }
+    }
+#endif
+    STATS_INC(STATS_ENCODED_STRKEYS);
     uint8_t buffer[35];
     buffer[0] = version_byte;
     for (uint8_t i = 0; i < 32; i++) {
@@ -88,10 +151,19 @@ bool encode_key(const uint8_t *in, uint8_t version_byte, char *out, uint8_t out_
     uint16_t crc = crc16(buffer, 33);  // checksum
     buffer[33] = crc;
     buffer[34] = crc >> 8;
-    if (base32_encode(buffer, 35, (uint8_t *) out, 56) == -1) {
+    if (base32_encode_blocks(buffer, 35, (uint8_t *) out, 56) == -1) {
         return false;
     }
     out[56] = '\0';
+#ifdef HAVE_STRKEY_CACHE
+    if (strkey_cache != NULL) {
+        strkey_cache_entry_t *entry = &strkey_cache->entries[strkey_cache->next];
+        entry->version_byte = version_byte;
+        memcpy(entry->raw_key, in, 32);
+        memcpy(entry->encoded, out, 56);
+        strkey_cache->next = (strkey_cache->next + 1) % STRKEY_CACHE_SIZE;
+    }
+#endif
     return true;
 }
 
@@ -136,7 +208,7 @@ bool encode_ed25519_signed_payload(const ed25519_signed_payload_t *signed_payloa
     uint16_t crc = crc16(buffer, data_len + 1);  // checksum
     buffer[1 + data_len] = crc;
     buffer[1 + data_len + 1] = crc >> 8;
-    int ret = base32_encode(buffer, data_len + 3, (uint8_t *) out, out_len);
+    int ret = base32_encode_blocks(buffer, data_len + 3, (uint8_t *) out, out_len);
     if (ret == -1) {
         return false;
     }
@@ -160,10 +232,10 @@ bool encode_muxed_account(const muxed_account_t *raw_muxed_account, char *out, s
         uint16_t crc = crc16(buffer, MUXED_ACCOUNT_MED_25519_SIZE - 2);  // checksum
         buffer[41] = crc;
         buffer[42] = crc >> 8;
-        if (base32_encode(buffer,
-                          MUXED_ACCOUNT_MED_25519_SIZE,
-                          (uint8_t *) out,
-                          ENCODED_MUXED_ACCOUNT_KEY_LENGTH) == -1) {
+        if (base32_encode_blocks(buffer,
+                                 MUXED_ACCOUNT_MED_25519_SIZE,
+                                 (uint8_t *) out,
+                                 ENCODED_MUXED_ACCOUNT_KEY_LENGTH) == -1) {
             return false;
         }
         out[69] = '\0';
@@ -303,37 +375,7 @@ bool print_claimable_balance_id(const claimable_balance_id *claimable_balance_id
 }
 
 bool print_uint(uint64_t num, char *out, size_t out_len) {
-    char buffer[AMOUNT_MAX_LENGTH];
-    uint64_t d_val = num;
-    size_t i, j;
-
-    if (num == 0) {
-        if (out_len < 2) {
-            return false;
-        }
-        if (strlcpy(out, "0", out_len) >= out_len) {
-            return false;
-        }
-        return true;
-    }
-
-    memset(buffer, 0, AMOUNT_MAX_LENGTH);
-    for (i = 0; d_val > 0; i++) {
-        if (i >= AMOUNT_MAX_LENGTH) {
-            return false;
-        }
-        buffer[i] = (d_val % 10) + '0';
-        d_val /= 10;
-    }
-    if (out_len <= i) {
-        return false;
-    }
-    // reverse order
-    for (j = 0; j < i; j++) {
-        out[j] = buffer[i - j - 1];
-    }
-    out[i] = '\0';
-    return true;
+    return format_u64(out, out_len, num);
 }
 
 bool print_int(int64_t num, char *out, size_t out_len) {
@@ -359,30 +401,36 @@ bool print_time(uint64_t seconds, char *out, size_t out_len) {
         // valid range 1970-01-01 00:00:00 - 9999-12-31 23:59:59
         return false;
     }
-    char time_str[20] = {0};  // 1970-01-01 00:00:00
-
-    if (out_len < sizeof(time_str)) {
-        return false;
-    }
-    struct tm tm;
-    if (!gmtime_r((time_t *) &seconds, &tm)) {
-        return false;
-    };
-
-    if (snprintf(time_str,
-                 sizeof(time_str),
-                 "%04d-%02d-%02d %02d:%02d:%02d",
-                 tm.tm_year + 1900,
-                 tm.tm_mon + 1,
-                 tm.tm_mday,
-                 tm.tm_hour,
-                 tm.tm_min,
-                 tm.tm_sec) < 0) {
-        return false;
-    };
-    if (strlcpy(out, time_str, out_len) >= out_len) {
+    if (out_len < 20) {  // 1970-01-01 00:00:00
         return false;
     }
+    uint32_t days = seconds / 86400;
+    uint32_t time = seconds - (uint64_t) days * 86400;
+
+    // civil date from the days since 1970-01-01, in eras of 400 years starting on March 1st
+    uint32_t z = days + 719468;
+    uint32_t era = z / 146097;
+    uint32_t day_of_era = z - era * 146097;
+    uint32_t year_of_era =
+        (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    uint32_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    uint32_t month_from_march = (5 * day_of_year + 2) / 153;
+    uint32_t day = day_of_year - (153 * month_from_march + 2) / 5 + 1;
+    uint32_t month = month_from_march < 10 ? month_from_march + 3 : month_from_march - 9;
+    uint32_t year = year_of_era + era * 400 + (month <= 2);
+
+    format_u32_digits(out, year, 4);
+    out[4] = '-';
+    format_u32_digits(out + 5, month, 2);
+    out[7] = '-';
+    format_u32_digits(out + 8, day, 2);
+    out[10] = ' ';
+    format_u32_digits(out + 11, time / 3600, 2);
+    out[13] = ':';
+    format_u32_digits(out + 14, time / 60 % 60, 2);
+    out[16] = ':';
+    format_u32_digits(out + 17, time % 60, 2);
+    out[19] = '\0';
     return true;
 }
 
@@ -524,49 +572,44 @@ bool print_amount(uint64_t amount,
                   uint8_t network_id,
                   char *out,
                   size_t out_len) {
-    char buffer[AMOUNT_WITH_COMMAS_MAX_LENGTH] = {0};
-    uint64_t d_val = amount;
-    int i;
-
-    for (i = 0; d_val > 0 || i < 9; i++) {
-        // len('100.0000001') == 11
-        if (i >= 11 && i < AMOUNT_WITH_COMMAS_MAX_LENGTH && (i - 11) % 4 == 0) {
-            buffer[i] = ',';
-            i += 1;
-        }
-        if (i >= AMOUNT_WITH_COMMAS_MAX_LENGTH) {
-            return false;
-        }
-        if (d_val > 0) {
-            buffer[i] = (d_val % 10) + '0';
-            d_val /= 10;
-        } else {
-            buffer[i] = '0';
-        }
-        if (i == 6) {  // stroops to xlm: 1 xlm = 10000000 stroops
-            i += 1;
-            buffer[i] = '.';
-        }
-        if (i >= AMOUNT_WITH_COMMAS_MAX_LENGTH) {
-            return false;
-        }
-    }
+    char buffer[AMOUNT_WITH_COMMAS_MAX_LENGTH];
+    size_t len = 0;
 
-    // reverse order
-    for (int j = 0; j < i / 2; j++) {
-        char c = buffer[j];
-        buffer[j] = buffer[i - j - 1];
-        buffer[i - j - 1] = c;
+    // stroops to xlm: 1 xlm = 10000000 stroops, the rest of the digits is computed in 32 bits
+    uint64_t integer = amount / 10000000;
+    uint32_t fraction = amount - integer * 10000000;
+    if (integer >= 1000000000000) {  // 1,000,000,000,000.0000001 doesn't fit
+        return false;
     }
-
-    // strip trailing 0s
-    i -= 1;
-    while (buffer[i] == '0') {
-        buffer[i] = 0;
-        i -= 1;
+    uint32_t high = integer / 1000000000;
+    uint32_t low = integer - (uint64_t) high * 1000000000;
+    uint32_t groups[4] = {high, low / 1000000, low / 1000 % 1000, low % 1000};
+
+    // thousands groups, the leading one without padding
+    uint8_t group = 0;
+    while (group < 3 && groups[group] == 0) {
+        group++;
+    }
+    uint8_t digits = groups[group] >= 100 ? 3 : groups[group] >= 10 ? 2 : 1;
+    format_u32_digits(buffer, groups[group], digits);
+    len += digits;
+    for (group++; group < 4; group++) {
+        buffer[len++] = ',';
+        format_u32_digits(buffer + len, groups[group], 3);
+        len += 3;
+    }
+
+    // fractional part without trailing 0s
+    if (fraction != 0) {
+        buffer[len++] = '.';
+        format_u32_digits(buffer + len, fraction, 7);
+        len += 7;
+        while (buffer[len - 1] == '0') {
+            len--;
+        }
     }
-    // strip trailing .
-    if (buffer[i] == '.') buffer[i] = 0;
+    buffer[len] = '\0';
+
     if (strlcpy(out, buffer, out_len) >= out_len) {
         return false;
     }
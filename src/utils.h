@@ -2,6 +2,19 @@
 
 #include "./types.h"
 
+/*
+ * CRC16-XModem checksum of StrKeys, nibble-wise by default or byte-wise with CRC16_BYTE_TABLE
+ * defined (faster, its 512 bytes table takes 480 more bytes of flash than the nibble one).
+ */
+uint16_t crc16(const uint8_t *input_str, int num_bytes);
+
+#ifdef HAVE_STRKEY_CACHE
+/*
+ * Keys encoded by encode_key are looked up in and added to cache until it is set back to NULL.
+ */
+void set_strkey_cache(strkey_cache_t *cache);
+#endif
+
 bool encode_ed25519_public_key(const uint8_t raw_public_key[static RAW_ED25519_PUBLIC_KEY_SIZE],
                                char *out,
                                size_t out_len);
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "ux.h"
+
+extern const bagl_icon_details_t C_icon_crossmark;
+extern const bagl_icon_details_t C_icon_eye;
+extern const bagl_icon_details_t C_icon_validate_14;
+extern const bagl_icon_details_t C_icon_warning;
@@ -0,0 +1,4 @@
+#pragma once
+
+// strlcpy and strlcat are provided by the SDK on the device
+#include <bsd/string.h>
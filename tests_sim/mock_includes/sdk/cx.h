@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned int cx_curve_t;
+
+#define CX_CURVE_Ed25519 0x71
+
+typedef enum cx_md_e { CX_NONE, CX_SHA256 = 3, CX_SHA512 = 5 } cx_md_t;
+
+#define CX_LAST (1 << 0)
+
+typedef struct cx_hash_header_s {
+    cx_md_t algo;
+    unsigned int counter;
+} cx_hash_t;
+
+typedef struct cx_sha256_s {
+    cx_hash_t header;
+    uint32_t state[8];
+    uint64_t length;  // bytes hashed
+    uint8_t block[64];
+    size_t blen;  // bytes of the pending block
+} cx_sha256_t;
+
+int cx_sha256_init(cx_sha256_t *hash);
+int cx_hash(cx_hash_t *hash,
+            int mode,
+            const unsigned char *in,
+            size_t len,
+            unsigned char *out,
+            size_t out_len);
+
+typedef struct cx_ecfp_256_public_key_s {
+    cx_curve_t curve;
+    unsigned int W_len;
+    unsigned char W[65];
+} cx_ecfp_public_key_t;
+
+typedef struct cx_ecfp_256_private_key_s {
+    cx_curve_t curve;
+    unsigned int d_len;
+    unsigned char d[32];
+} cx_ecfp_private_key_t;
+
+int cx_ecfp_init_private_key(cx_curve_t curve,
+                             const unsigned char *raw_key,
+                             unsigned int key_len,
+                             cx_ecfp_private_key_t *pvkey);
+int cx_ecfp_generate_pair(cx_curve_t curve,
+                          cx_ecfp_public_key_t *pubkey,
+                          cx_ecfp_private_key_t *privkey,
+                          int keepprivate);
+/*
+ * Not an EdDSA signature: SHA-256(key || message) || SHA-256(first half || message), enough to
+ * check which key signed which message.
+ */
+int cx_eddsa_sign(const cx_ecfp_private_key_t *pvkey,
+                  int mode,
+                  cx_md_t hashID,
+                  const unsigned char *hash,
+                  unsigned int hash_len,
+                  const unsigned char *ctx,
+                  unsigned int ctx_len,
+                  unsigned char *sig,
+                  unsigned int sig_len,
+                  unsigned int *info);
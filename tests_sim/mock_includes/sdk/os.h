@@ -0,0 +1,130 @@
+#pragma once
+
+#include <setjmp.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <bsd/string.h>
+
+#include "cx.h"
+
+#define PRINTF(...)
+#define PIC(x)     (x)
+#define UNUSED(x)  (void) (x)
+
+/*
+ * Exceptions, same semantics as the SDK: THROW jumps to the innermost TRY, whose CATCH or
+ * CATCH_OTHER closes it, and END_TRY throws again what wasn't caught.
+ */
+typedef unsigned short exception_t;
+
+typedef struct try_context_s {
+    jmp_buf jmp_buf;
+    struct try_context_s *previous;
+    exception_t ex;
+} try_context_t;
+
+try_context_t *try_context_get(void);
+try_context_t *try_context_set(try_context_t *context);
+void os_longjmp(unsigned int exception) __attribute__((noreturn));
+
+#define BEGIN_TRY_L(L) \
+    {                  \
+        try_context_t __try##L;
+#define TRY_L(L)                                          \
+    __try##L.previous = try_context_set(&__try##L);       \
+    __try##L.ex = (exception_t) setjmp(__try##L.jmp_buf); \
+    if (__try##L.ex == 0) {
+#define CATCH_L(L, x)          \
+    goto __FINALLY##L;         \
+    }                          \
+    else if (__try##L.ex == (x)) { \
+        __try##L.ex = 0;       \
+        CLOSE_TRY_L(L);
+#define CATCH_OTHER_L(L, e)     \
+    goto __FINALLY##L;          \
+    }                           \
+    else {                      \
+        exception_t e;          \
+        e = __try##L.ex;        \
+        __try##L.ex = 0;        \
+        CLOSE_TRY_L(L);
+#define CATCH_ALL_L(L)   \
+    goto __FINALLY##L;   \
+    }                    \
+    else {               \
+        __try##L.ex = 0; \
+        CLOSE_TRY_L(L);
+#define FINALLY_L(L)                         \
+    goto __FINALLY##L;                       \
+    }                                        \
+    __FINALLY##L:                            \
+    if (try_context_get() == &__try##L) {    \
+        CLOSE_TRY_L(L);                      \
+    }
+#define END_TRY_L(L)              \
+    if (__try##L.ex != 0) {       \
+        THROW_L(L, __try##L.ex);  \
+    }                             \
+    }
+#define CLOSE_TRY_L(L) try_context_set(__try##L.previous)
+#define THROW_L(L, x)  os_longjmp(x)
+
+#define BEGIN_TRY      BEGIN_TRY_L(_)
+#define TRY            TRY_L(_)
+#define CATCH(x)       CATCH_L(_, x)
+#define CATCH_OTHER(e) CATCH_OTHER_L(_, e)
+#define CATCH_ALL      CATCH_ALL_L(_)
+#define FINALLY        FINALLY_L(_)
+#define END_TRY        END_TRY_L(_)
+#define CLOSE_TRY      CLOSE_TRY_L(_)
+#define THROW(x)       os_longjmp(x)
+
+#define EXCEPTION_IO_RESET 0x10
+#define INVALID_PARAMETER  2
+
+/*
+ * IO, the APDU buffer is enlarged by CUSTOM_IO_APDU_BUFFER_SIZE as in the SDK.
+ */
+#ifdef CUSTOM_IO_APDU_BUFFER_SIZE
+#define IO_APDU_BUFFER_SIZE CUSTOM_IO_APDU_BUFFER_SIZE
+#else
+#define IO_APDU_BUFFER_SIZE (5 + 255)
+#endif
+
+#define CHANNEL_APDU           0
+#define CHANNEL_KEYBOARD       1
+#define CHANNEL_SPI            2
+#define IO_RESET_AFTER_REPLIED 0x80
+#define IO_RECEIVE_DATA        0x40
+#define IO_RETURN_AFTER_TX     0x20
+#define IO_ASYNCH_REPLY        0x10
+#define IO_FLAGS               0xF8
+
+#define IO_APDU_MEDIA_USB_HID 1
+
+#define U4BE(buf, off)                                                                    \
+    (((uint32_t) (buf)[off] << 24) | ((uint32_t) (buf)[(off) + 1] << 16) | \
+     ((uint32_t) (buf)[(off) + 2] << 8) | (uint32_t) (buf)[(off) + 3])
+
+extern unsigned char G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+extern unsigned int G_io_apdu_media;
+
+unsigned short io_exchange(unsigned char channel_and_flags, unsigned short tx_len);
+void halt(void);
+
+/*
+ * Keys, derived from the path only.
+ */
+#define HDW_ED25519_SLIP10 1
+
+void os_perso_derive_node_with_seed_key(unsigned int mode,
+                                        cx_curve_t curve,
+                                        const unsigned int *path,
+                                        unsigned int path_length,
+                                        unsigned char *private_key,
+                                        unsigned char *chain,
+                                        unsigned char *seed_key,
+                                        unsigned int seed_key_length);
+
+void nvm_write(void *dst_adr, void *src_adr, unsigned int src_len);
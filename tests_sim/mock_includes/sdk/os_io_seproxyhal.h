@@ -0,0 +1,20 @@
+#pragma once
+
+#include "os.h"
+#include "ux.h"
+
+#define SEPROXYHAL_TAG_BUTTON_PUSH_EVENT             0x05
+#define SEPROXYHAL_TAG_STATUS_EVENT                  0x0E
+#define SEPROXYHAL_TAG_STATUS_EVENT_FLAG_USB_POWERED 0x00000008
+#define SEPROXYHAL_TAG_DISPLAY_PROCESSED_EVENT       0x0D
+#define SEPROXYHAL_TAG_TICKER_EVENT                  0x0C
+
+extern unsigned char G_io_seproxyhal_spi_buffer[IO_SEPROXYHAL_BUFFER_SIZE_B];
+
+void io_seproxyhal_display_default(const bagl_element_t *element);
+void io_seproxyhal_general_status(void);
+unsigned int io_seproxyhal_spi_is_status_sent(void);
+void io_seproxyhal_spi_send(const unsigned char *buffer, unsigned short length);
+unsigned short io_seproxyhal_spi_recv(unsigned char *buffer,
+                                      unsigned short max_length,
+                                      unsigned int flags);
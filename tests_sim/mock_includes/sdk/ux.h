@@ -0,0 +1,112 @@
+#pragma once
+
+#include "os.h"
+
+/*
+ * Flows of steps, each step shows a layout or runs its init callback, which moves to another
+ * step. The layouts are not drawn, the simulator prints their lines.
+ */
+typedef struct bagl_element_s {
+    int unused;
+} bagl_element_t;
+
+typedef struct bagl_icon_details_s {
+    const char *name;
+} bagl_icon_details_t;
+
+typedef struct {
+    const bagl_icon_details_t *icon;
+    const char *line1;
+    const char *line2;
+} ux_layout_pnn_params_t;
+
+typedef ux_layout_pnn_params_t ux_layout_pbb_params_t;
+typedef ux_layout_pnn_params_t ux_layout_pb_params_t;
+typedef ux_layout_pnn_params_t ux_layout_pn_params_t;
+
+typedef struct {
+    const char *title;
+    const char *text;
+} ux_layout_bnnn_paging_params_t;
+
+typedef struct ux_flow_step_s {
+    void (*init)(unsigned int stack_slot);
+    const char *layout;  // NULL for the steps only running their init callback
+    const void *params;
+    void (*validate)(void);
+} ux_flow_step_t;
+
+typedef const ux_flow_step_t *const ux_flow_step_array_t[];
+
+#define FLOW_END_STEP ((const ux_flow_step_t *) NULL)
+
+#define UX_STEP_NOCB(stepname, layoutkind, ...)                                          \
+    static const ux_layout_##layoutkind##_params_t stepname##_val = __VA_ARGS__;        \
+    static const ux_flow_step_t stepname = {NULL, #layoutkind, &stepname##_val, NULL}
+#define UX_STEP_CB(stepname, layoutkind, validate_cb, ...)                               \
+    static void stepname##_validate(void) {                                              \
+        validate_cb;                                                                     \
+    }                                                                                    \
+    static const ux_layout_##layoutkind##_params_t stepname##_val = __VA_ARGS__;        \
+    static const ux_flow_step_t stepname = {NULL,                                        \
+                                            #layoutkind,                                 \
+                                            &stepname##_val,                             \
+                                            stepname##_validate}
+#define UX_STEP_INIT(stepname, error_flow, validate_flow, ...)              \
+    static void stepname##_init(unsigned int stack_slot) {                  \
+        (void) stack_slot;                                                  \
+        __VA_ARGS__                                                         \
+    }                                                                       \
+    static const ux_flow_step_t stepname = {stepname##_init, NULL, NULL, NULL}
+#define UX_FLOW(flow_name, ...) \
+    static const ux_flow_step_t *const flow_name[] = {__VA_ARGS__, FLOW_END_STEP}
+
+typedef struct {
+    const ux_flow_step_t *const *steps;
+    unsigned char index;
+    unsigned char prev_index;
+} ux_flow_state_t;
+
+typedef struct ux_state_s {
+    unsigned char stack_count;
+    ux_flow_state_t flow_stack[1];
+} ux_state_t;
+
+extern ux_state_t G_ux;
+
+typedef struct bolos_ux_params_s {
+    unsigned int len;
+} bolos_ux_params_t;
+
+void ux_flow_init(unsigned int stack_slot,
+                  const ux_flow_step_t *const *steps,
+                  const ux_flow_step_t *const start_step);
+void ux_flow_next(void);
+void ux_flow_prev(void);
+void ux_flow_relayout(void);
+
+#define BAGL_FONT_OPEN_SANS_EXTRABOLD_11px 8
+#define BAGL_FONT_OPEN_SANS_REGULAR_11px   10
+#define BAGL_ENCODING_LATIN1               0
+
+/*
+ * Width in pixels of a text line, approximated with a fixed width per character of the font.
+ */
+unsigned short bagl_compute_line_width(unsigned short font_id,
+                                       unsigned short width,
+                                       const void *text,
+                                       unsigned char text_length,
+                                       unsigned char text_encoding);
+
+#define BUTTON_LEFT  1
+#define BUTTON_RIGHT 2
+
+/*
+ * Left and right move to the previous and next steps, both validate the step.
+ */
+void ux_button_push(unsigned int buttons);
+
+#define UX_BUTTON_PUSH_EVENT(seph_packet)        ux_button_push((seph_packet)[3])
+#define UX_DISPLAYED_EVENT(callback)             (void) 0
+#define UX_TICKER_EVENT(seph_packet, callback)   (void) (seph_packet)
+#define UX_DEFAULT_EVENT()                       (void) 0
@@ -0,0 +1,398 @@
+/*
+ * Host implementation of the SDK functions used by the app: exceptions, IO, hashing, keys and
+ * the UX flows. Keys and signatures are derived with SHA-256 only, they are deterministic but
+ * are not the ones of a device.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "os.h"
+#include "cx.h"
+#include "ux.h"
+#include "os_io_seproxyhal.h"
+
+#include "ui/ui.h"  // ui_menu_main, glyphs
+
+#include "./mock_sdk.h"
+
+/*
+ * Exceptions
+ */
+
+static try_context_t *try_context;
+
+try_context_t *try_context_get(void) {
+    return try_context;
+}
+
+try_context_t *try_context_set(try_context_t *context) {
+    try_context_t *previous = try_context;
+    try_context = context;
+    return previous;
+}
+
+void os_longjmp(unsigned int exception) {
+    if (try_context == NULL) {
+        fprintf(stderr, "uncaught exception 0x%04X\n", exception);
+        exit(EXIT_FAILURE);
+    }
+    longjmp(try_context->jmp_buf, (int) exception);
+}
+
+/*
+ * SHA-256
+ */
+
+static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+    0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+    0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+    0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+    0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+    0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+    0xc67178f2};
+
+#define ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void sha256_block(cx_sha256_t *hash, const uint8_t *block) {
+    uint32_t w[64];
+    uint32_t s[8];
+
+    for (int i = 0; i < 16; i++) {
+        w[i] = (uint32_t) block[4 * i] << 24 | (uint32_t) block[4 * i + 1] << 16 |
+               (uint32_t) block[4 * i + 2] << 8 | block[4 * i + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = ROTR(w[i - 15], 7) ^ ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = ROTR(w[i - 2], 17) ^ ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    memcpy(s, hash->state, sizeof(s));
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = s[7] + (ROTR(s[4], 6) ^ ROTR(s[4], 11) ^ ROTR(s[4], 25)) +
+                      ((s[4] & s[5]) ^ (~s[4] & s[6])) + SHA256_K[i] + w[i];
+        uint32_t t2 = (ROTR(s[0], 2) ^ ROTR(s[0], 13) ^ ROTR(s[0], 22)) +
+                      ((s[0] & s[1]) ^ (s[0] & s[2]) ^ (s[1] & s[2]));
+        memmove(s + 1, s, 7 * sizeof(uint32_t));
+        s[4] += t1;
+        s[0] = t1 + t2;
+    }
+    for (int i = 0; i < 8; i++) {
+        hash->state[i] += s[i];
+    }
+}
+
+int cx_sha256_init(cx_sha256_t *hash) {
+    static const uint32_t SHA256_IV[8] = {0x6a09e667,
+                                          0xbb67ae85,
+                                          0x3c6ef372,
+                                          0xa54ff53a,
+                                          0x510e527f,
+                                          0x9b05688c,
+                                          0x1f83d9ab,
+                                          0x5be0cd19};
+    memset(hash, 0, sizeof(*hash));
+    hash->header.algo = CX_SHA256;
+    memcpy(hash->state, SHA256_IV, sizeof(SHA256_IV));
+    return CX_SHA256;
+}
+
+int cx_hash(cx_hash_t *header,
+            int mode,
+            const unsigned char *in,
+            size_t len,
+            unsigned char *out,
+            size_t out_len) {
+    cx_sha256_t *hash = (cx_sha256_t *) header;
+
+    hash->length += len;
+    while (len > 0) {
+        size_t n = 64 - hash->blen < len ? 64 - hash->blen : len;
+        memcpy(hash->block + hash->blen, in, n);
+        hash->blen += n;
+        in += n;
+        len -= n;
+        if (hash->blen == 64) {
+            sha256_block(hash, hash->block);
+            hash->blen = 0;
+        }
+    }
+    if (!(mode & CX_LAST)) {
+        return 0;
+    }
+
+    uint64_t bits = hash->length * 8;
+    uint8_t padding[72] = {0x80};
+    size_t padding_len = (hash->blen < 56 ? 56 : 120) - hash->blen;
+    for (int i = 0; i < 8; i++) {
+        padding[padding_len + i] = bits >> (56 - 8 * i);
+    }
+    cx_hash(header, 0, padding, padding_len + 8, NULL, 0);
+    if (out_len < 32) {
+        THROW(INVALID_PARAMETER);
+    }
+    for (int i = 0; i < 32; i++) {
+        out[i] = hash->state[i / 4] >> (24 - 8 * (i % 4));
+    }
+    return 32;
+}
+
+static void sha256(const uint8_t *a, size_t a_len, const uint8_t *b, size_t b_len, uint8_t *out) {
+    cx_sha256_t hash;
+    cx_sha256_init(&hash);
+    cx_hash(&hash.header, 0, a, a_len, NULL, 0);
+    cx_hash(&hash.header, CX_LAST, b, b_len, out, 32);
+}
+
+/*
+ * Keys
+ */
+
+void os_perso_derive_node_with_seed_key(unsigned int mode,
+                                        cx_curve_t curve,
+                                        const unsigned int *path,
+                                        unsigned int path_length,
+                                        unsigned char *private_key,
+                                        unsigned char *chain,
+                                        unsigned char *seed_key,
+                                        unsigned int seed_key_length) {
+    (void) mode;
+    (void) curve;
+    (void) chain;
+    uint8_t raw_path[10 * 4];
+
+    if (path_length > 10) {
+        THROW(INVALID_PARAMETER);
+    }
+    for (unsigned int i = 0; i < path_length; i++) {
+        raw_path[4 * i] = path[i] >> 24;
+        raw_path[4 * i + 1] = path[i] >> 16;
+        raw_path[4 * i + 2] = path[i] >> 8;
+        raw_path[4 * i + 3] = path[i];
+    }
+    sha256(seed_key, seed_key_length, raw_path, 4 * path_length, private_key);
+}
+
+int cx_ecfp_init_private_key(cx_curve_t curve,
+                             const unsigned char *raw_key,
+                             unsigned int key_len,
+                             cx_ecfp_private_key_t *pvkey) {
+    if (key_len != sizeof(pvkey->d)) {
+        THROW(INVALID_PARAMETER);
+    }
+    pvkey->curve = curve;
+    pvkey->d_len = key_len;
+    memcpy(pvkey->d, raw_key, key_len);
+    return key_len;
+}
+
+int cx_ecfp_generate_pair(cx_curve_t curve,
+                          cx_ecfp_public_key_t *pubkey,
+                          cx_ecfp_private_key_t *privkey,
+                          int keepprivate) {
+    (void) keepprivate;
+    pubkey->curve = curve;
+    pubkey->W_len = sizeof(pubkey->W);
+    pubkey->W[0] = 0x04;
+    sha256(privkey->d, sizeof(privkey->d), NULL, 0, pubkey->W + 1);
+    sha256(pubkey->W + 1, 32, NULL, 0, pubkey->W + 33);
+    return 0;
+}
+
+int cx_eddsa_sign(const cx_ecfp_private_key_t *pvkey,
+                  int mode,
+                  cx_md_t hashID,
+                  const unsigned char *hash,
+                  unsigned int hash_len,
+                  const unsigned char *ctx,
+                  unsigned int ctx_len,
+                  unsigned char *sig,
+                  unsigned int sig_len,
+                  unsigned int *info) {
+    (void) mode;
+    (void) hashID;
+    (void) ctx;
+    (void) ctx_len;
+    (void) info;
+
+    if (sig_len < 64) {
+        THROW(INVALID_PARAMETER);
+    }
+    sha256(pvkey->d, sizeof(pvkey->d), hash, hash_len, sig);
+    sha256(sig, 32, hash, hash_len, sig + 32);
+    return 64;
+}
+
+/*
+ * IO and NVRAM
+ */
+
+unsigned char G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+unsigned int G_io_apdu_media = IO_APDU_MEDIA_USB_HID;
+
+// not const as on the device, so that the simulator can change the settings
+uint8_t N_storage_real;
+
+void io_seproxyhal_display_default(const bagl_element_t *element) {
+    (void) element;
+}
+
+void io_seproxyhal_general_status(void) {
+}
+
+unsigned int io_seproxyhal_spi_is_status_sent(void) {
+    return 1;
+}
+
+void io_seproxyhal_spi_send(const unsigned char *buffer, unsigned short length) {
+    (void) buffer;
+    (void) length;
+}
+
+unsigned short io_seproxyhal_spi_recv(unsigned char *buffer,
+                                      unsigned short max_length,
+                                      unsigned int flags) {
+    (void) buffer;
+    (void) max_length;
+    (void) flags;
+    return 0;
+}
+
+void halt(void) {
+    exit(EXIT_SUCCESS);
+}
+
+void nvm_write(void *dst_adr, void *src_adr, unsigned int src_len) {
+    memcpy(dst_adr, src_adr, src_len);
+}
+
+/*
+ * UX
+ */
+
+const bagl_icon_details_t C_icon_crossmark = {"crossmark"};
+const bagl_icon_details_t C_icon_eye = {"eye"};
+const bagl_icon_details_t C_icon_validate_14 = {"validate"};
+const bagl_icon_details_t C_icon_warning = {"warning"};
+
+char G_sim_screen[SIM_SCREEN_MAX_LENGTH];
+
+unsigned short bagl_compute_line_width(unsigned short font_id,
+                                       unsigned short width,
+                                       const void *text,
+                                       unsigned char text_length,
+                                       unsigned char text_encoding) {
+    (void) width;
+    (void) text;
+    (void) text_encoding;
+    return text_length * (font_id == BAGL_FONT_OPEN_SANS_EXTRABOLD_11px ? 7 : 6);
+}
+
+static const ux_flow_step_t *current_step(void) {
+    if (G_ux.stack_count == 0) {
+        return NULL;
+    }
+    ux_flow_state_t *flow = &G_ux.flow_stack[G_ux.stack_count - 1];
+    return flow->steps[flow->index];
+}
+
+// Run the init callback of the step, or print the lines of its layout
+static void display_step(void) {
+    const ux_flow_step_t *step = current_step();
+
+    if (step->init != NULL) {
+        step->init(0);
+        return;
+    }
+    if (strcmp(step->layout, "bnnn_paging") == 0) {
+        const ux_layout_bnnn_paging_params_t *params = step->params;
+        snprintf(G_sim_screen, sizeof(G_sim_screen), "%s; %s", params->title, params->text);
+    } else {
+        const ux_layout_pnn_params_t *params = step->params;
+        if (params->line2 != NULL) {
+            snprintf(G_sim_screen, sizeof(G_sim_screen), "%s; %s", params->line1, params->line2);
+        } else {
+            snprintf(G_sim_screen, sizeof(G_sim_screen), "%s", params->line1);
+        }
+    }
+    sim_screen_displayed(G_sim_screen);
+}
+
+void ux_flow_init(unsigned int stack_slot,
+                  const ux_flow_step_t *const *steps,
+                  const ux_flow_step_t *const start_step) {
+    unsigned int index = 0;
+
+    (void) stack_slot;
+    while (start_step != NULL && steps[index] != FLOW_END_STEP && steps[index] != start_step) {
+        index++;
+    }
+    if (steps[index] == FLOW_END_STEP) {
+        index = 0;
+    }
+    G_ux.stack_count = 1;
+    G_ux.flow_stack[0].steps = steps;
+    G_ux.flow_stack[0].index = index;
+    G_ux.flow_stack[0].prev_index = index;
+    display_step();
+}
+
+void ux_flow_next(void) {
+    ux_flow_state_t *flow = &G_ux.flow_stack[G_ux.stack_count - 1];
+    if (flow->steps[flow->index + 1] == FLOW_END_STEP) {
+        return;
+    }
+    flow->prev_index = flow->index;
+    flow->index++;
+    display_step();
+}
+
+void ux_flow_prev(void) {
+    ux_flow_state_t *flow = &G_ux.flow_stack[G_ux.stack_count - 1];
+    if (flow->index == 0) {
+        return;
+    }
+    flow->prev_index = flow->index;
+    flow->index--;
+    display_step();
+}
+
+void ux_flow_relayout(void) {
+    display_step();
+}
+
+void ux_button_push(unsigned int buttons) {
+    const ux_flow_step_t *step = current_step();
+
+    if (step == NULL) {
+        return;
+    }
+    switch (buttons) {
+        case BUTTON_LEFT:
+            ux_flow_prev();
+            break;
+        case BUTTON_RIGHT:
+            ux_flow_next();
+            break;
+        case BUTTON_LEFT | BUTTON_RIGHT:
+            if (step->validate != NULL) {
+                step->validate();
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void ui_menu_main(void) {
+    G_ux.stack_count = 0;
+    snprintf(G_sim_screen, sizeof(G_sim_screen), "Stellar; is ready");
+    sim_screen_displayed(G_sim_screen);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdint.h>
+
+#define SIM_SCREEN_MAX_LENGTH 128
+
+/**
+ * Lines of the screen displayed, separated by "; " as in the unit tests testcases.
+ */
+extern char G_sim_screen[SIM_SCREEN_MAX_LENGTH];
+
+/**
+ * Settings of the app, see settings.h.
+ */
+extern uint8_t N_storage_real;
+
+/**
+ * Called by the UX flows each time a screen is displayed, implemented by the simulator.
+ */
+void sim_screen_displayed(const char *screen);
@@ -0,0 +1,372 @@
+/*
+ * Host-side simulator of the app: replays an APDU transcript through the APDU parser, the
+ * dispatcher, the handlers, io.c and the review flows, with the SDK mocked by mock_sdk.c.
+ *
+ * A transcript has one item per line, blank lines and lines starting with # are ignored:
+ *
+ *   => e0040000...   command sent to the app, in hex
+ *   <= 9000          response expected, in hex with the status word
+ *   right [n]        press the right button (n times), then a ticker event is delivered
+ *   left [n]         press the left button (n times)
+ *   both             press both buttons
+ *   ? Caption; Value screen expected to be displayed
+ *   settings 81      settings stored in NVRAM, in hex (see settings.h), 00 at the start
+ *
+ * Each exchange is timed from the command to its response, buttons included. With -n, the
+ * transcript is replayed n times and the mean time of each exchange is printed as CSV.
+ *
+ * usage: sim [-v] [-n iterations] transcript
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "os.h"
+#include "ux.h"
+
+#include "io.h"
+#include "sw.h"
+#include "globals.h"
+#include "apdu/apdu_parser.h"
+#include "apdu/dispatcher.h"
+#include "ui/ui.h"
+
+#include "./mock_sdk.h"
+
+#define TRANSCRIPT_MAX_LINES 4096
+#define LINE_MAX_LENGTH      (2 * IO_APDU_BUFFER_SIZE + 64)
+#define MAX_EXCHANGES        1024
+
+typedef struct {
+    uint8_t ins;
+    uint8_t p1;
+    uint8_t p2;
+    uint16_t lc;
+    uint64_t total_ns;
+} exchange_t;
+
+static const char *transcript_path;
+static char *lines[TRANSCRIPT_MAX_LINES];
+static int lines_count;
+static int next_line;
+static bool verbose;
+
+static bool done;            // no command left in the transcript
+static bool waiting_user;    // the app waits for the buttons before it responds
+static exchange_t exchanges[MAX_EXCHANGES];
+static int exchanges_count;  // exchanges of the current run
+static uint64_t exchange_start;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void fail(const char *message, const char *detail) {
+    fprintf(stderr, "%s:%d: %s%s\n", transcript_path, next_line, message, detail);
+    exit(EXIT_FAILURE);
+}
+
+static void load_transcript(void) {
+    char line[LINE_MAX_LENGTH];
+    FILE *f = fopen(transcript_path, "r");
+
+    if (f == NULL) {
+        perror(transcript_path);
+        exit(EXIT_FAILURE);
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (lines_count == TRANSCRIPT_MAX_LINES) {
+            fail("too many lines", "");
+        }
+        line[strcspn(line, "\r\n")] = '\0';
+        lines[lines_count++] = strdup(line);
+    }
+    fclose(f);
+}
+
+// Next line which is not blank or a comment, NULL at the end of the transcript
+static const char *read_line(void) {
+    while (next_line < lines_count) {
+        const char *line = lines[next_line++];
+        line += strspn(line, " \t");
+        if (line[0] != '\0' && line[0] != '#') {
+            return line;
+        }
+    }
+    return NULL;
+}
+
+static bool starts_with(const char *line, const char *prefix) {
+    return strncmp(line, prefix, strlen(prefix)) == 0;
+}
+
+static int parse_hex(const char *hex, uint8_t *out, size_t out_len) {
+    size_t len = 0;
+    int nibbles = 0;
+
+    for (; *hex != '\0'; hex++) {
+        int value;
+        if (*hex >= '0' && *hex <= '9') {
+            value = *hex - '0';
+        } else if (*hex >= 'a' && *hex <= 'f') {
+            value = *hex - 'a' + 10;
+        } else if (*hex >= 'A' && *hex <= 'F') {
+            value = *hex - 'A' + 10;
+        } else if (*hex == ' ' || *hex == '\t') {
+            continue;
+        } else {
+            return -1;
+        }
+        if (nibbles % 2 == 0) {
+            if (len == out_len) {
+                return -1;
+            }
+            out[len++] = value << 4;
+        } else {
+            out[len - 1] |= value;
+        }
+        nibbles++;
+    }
+    return nibbles % 2 == 0 ? (int) len : -1;
+}
+
+static void print_hex(const char *prefix, const uint8_t *data, size_t len) {
+    printf("%s", prefix);
+    for (size_t i = 0; i < len; i++) {
+        printf("%02x", data[i]);
+    }
+    printf("\n");
+}
+
+void sim_screen_displayed(const char *screen) {
+    if (verbose) {
+        printf("   %s\n", screen);
+    }
+}
+
+static void press_buttons(unsigned int buttons) {
+    G_io_seproxyhal_spi_buffer[0] = SEPROXYHAL_TAG_BUTTON_PUSH_EVENT;
+    G_io_seproxyhal_spi_buffer[1] = 0;
+    G_io_seproxyhal_spi_buffer[2] = 1;
+    G_io_seproxyhal_spi_buffer[3] = buttons;
+    io_event(CHANNEL_SPI);
+
+    // as on the device, the app gets ticker events while the user reads the screen
+    G_io_seproxyhal_spi_buffer[0] = SEPROXYHAL_TAG_TICKER_EVENT;
+    io_event(CHANNEL_SPI);
+}
+
+// Buttons, screens and settings, false for the other lines
+static bool run_user_line(const char *line) {
+    unsigned int buttons;
+    const char *arg;
+
+    if (starts_with(line, "?")) {
+        arg = line + 1 + strspn(line + 1, " ");
+        if (strcmp(G_sim_screen, arg) != 0) {
+            fail("screen displayed: ", G_sim_screen);
+        }
+        return true;
+    }
+    if (starts_with(line, "settings")) {
+        uint8_t settings;
+        if (parse_hex(line + strlen("settings"), &settings, 1) != 1) {
+            fail("invalid settings: ", line);
+        }
+        N_storage_real = settings;
+        return true;
+    }
+    if (starts_with(line, "left")) {
+        buttons = BUTTON_LEFT;
+        arg = line + strlen("left");
+    } else if (starts_with(line, "right")) {
+        buttons = BUTTON_RIGHT;
+        arg = line + strlen("right");
+    } else if (starts_with(line, "both")) {
+        buttons = BUTTON_LEFT | BUTTON_RIGHT;
+        arg = line + strlen("both");
+    } else {
+        return false;
+    }
+
+    int count = *arg != '\0' ? atoi(arg) : 1;
+    if (count <= 0) {
+        fail("invalid count of presses: ", line);
+    }
+    for (int i = 0; i < count; i++) {
+        if (verbose) {
+            printf("%.*s\n", (int) strcspn(line, " "), line);
+        }
+        press_buttons(buttons);
+    }
+    return true;
+}
+
+static void check_response(const uint8_t *response, size_t len) {
+    uint8_t expected[IO_APDU_BUFFER_SIZE];
+    const char *line = read_line();
+
+    exchanges[exchanges_count - 1].total_ns += now_ns() - exchange_start;
+    waiting_user = false;
+    if (verbose) {
+        print_hex("<= ", response, len);
+    }
+    if (line == NULL || !starts_with(line, "<=")) {
+        print_hex("response: ", response, len);
+        fail("response not expected", "");
+    }
+    int expected_len = parse_hex(line + 2, expected, sizeof(expected));
+    if (expected_len < 0) {
+        fail("invalid response: ", line);
+    }
+    if ((size_t) expected_len != len || memcmp(expected, response, len) != 0) {
+        print_hex("response: ", response, len);
+        fail("response doesn't match", "");
+    }
+}
+
+unsigned short io_exchange(unsigned char channel_and_flags, unsigned short tx_len) {
+    const char *line;
+
+    if (channel_and_flags & IO_RETURN_AFTER_TX) {
+        check_response(G_io_apdu_buffer, tx_len);
+        return 0;
+    }
+
+    if (channel_and_flags & IO_ASYNCH_REPLY) {
+        // the response is sent by the flow once the user approved or rejected
+        waiting_user = true;
+        while (waiting_user) {
+            line = read_line();
+            if (line == NULL || !run_user_line(line)) {
+                fail("the app waits for the user", "");
+            }
+        }
+    } else if (tx_len > 0) {
+        check_response(G_io_apdu_buffer, tx_len);
+    }
+
+    while ((line = read_line()) != NULL) {
+        if (starts_with(line, "=>")) {
+            int len = parse_hex(line + 2, G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+            if (len < 0) {
+                fail("invalid command: ", line);
+            }
+            if (exchanges_count == MAX_EXCHANGES) {
+                fail("too many exchanges", "");
+            }
+            exchange_t *exchange = &exchanges[exchanges_count++];
+            exchange->ins = len > 1 ? G_io_apdu_buffer[1] : 0;
+            exchange->p1 = len > 2 ? G_io_apdu_buffer[2] : 0;
+            exchange->p2 = len > 3 ? G_io_apdu_buffer[3] : 0;
+            exchange->lc = len > 5 ? len - (G_io_apdu_buffer[4] == 0 ? 7 : 5) : 0;
+            if (verbose) {
+                print_hex("=> ", G_io_apdu_buffer, len);
+            }
+            exchange_start = now_ns();
+            return len;
+        }
+        if (!run_user_line(line)) {
+            fail("a command is expected: ", line);
+        }
+    }
+    done = true;
+    return 0;
+}
+
+// Same loop as app_main, until the transcript has no command left
+static void run_transcript(void) {
+    command_t cmd;
+    int input_len;
+
+    next_line = 0;
+    done = false;
+    exchanges_count = 0;
+    G_output_len = 0;
+    G_io_state = READY;
+    N_storage_real = 0;
+    explicit_bzero(&G_context, sizeof(G_context));
+    ui_menu_main();
+
+    while (!done) {
+        BEGIN_TRY {
+            TRY {
+                memset(&cmd, 0, sizeof(cmd));
+                input_len = io_recv_command();
+                if (!done) {
+                    if (!apdu_parser(&cmd, G_io_apdu_buffer, input_len)) {
+                        io_send_sw(SW_WRONG_DATA_LENGTH);
+                    } else {
+                        apdu_dispatcher(&cmd);
+                    }
+                }
+            }
+            CATCH(EXCEPTION_IO_RESET) {
+                fail("IO reset", "");
+            }
+            CATCH_OTHER(e) {
+                io_send_sw(e);
+            }
+            FINALLY {
+            }
+        }
+        END_TRY;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "vn:")) != -1) {
+        switch (opt) {
+            case 'v':
+                verbose = true;
+                break;
+            case 'n':
+                iterations = atoi(optarg);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-v] [-n iterations] transcript\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (optind + 1 != argc || iterations < 0) {
+        fprintf(stderr, "usage: %s [-v] [-n iterations] transcript\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    transcript_path = argv[optind];
+    load_transcript();
+
+    run_transcript();
+    if (iterations == 0) {
+        return EXIT_SUCCESS;
+    }
+
+    // the first run only warmed up the caches
+    for (int i = 0; i < exchanges_count; i++) {
+        exchanges[i].total_ns = 0;
+    }
+    verbose = false;
+    for (int i = 0; i < iterations; i++) {
+        run_transcript();
+    }
+    printf("exchange,ins,p1,p2,lc,ns\n");
+    for (int i = 0; i < exchanges_count; i++) {
+        printf("%d,%02x,%02x,%02x,%u,%.0f\n",
+               i,
+               exchanges[i].ins,
+               exchanges[i].p1,
+               exchanges[i].p2,
+               exchanges[i].lc,
+               (double) exchanges[i].total_ns / iterations);
+    }
+    return EXIT_SUCCESS;
+}
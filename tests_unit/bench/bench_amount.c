@@ -0,0 +1,164 @@
+/*
+ * Host-side microbenchmark of print_amount and print_uint against the digit by digit
+ * implementations they replaced, printed as CSV.
+ *
+ * usage: bench_amount [-n iterations]
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "utils.h"
+
+#define DEFAULT_ITERATIONS 1000000
+#define AMOUNTS_COUNT      1024
+
+// previous print_amount, without the asset
+static bool print_amount_digit_loop(uint64_t amount, char *out, size_t out_len) {
+    char buffer[24] = {0};
+    uint64_t d_val = amount;
+    int i;
+
+    for (i = 0; d_val > 0 || i < 9; i++) {
+        if (i >= 11 && i < 24 && (i - 11) % 4 == 0) {
+            buffer[i] = ',';
+            i += 1;
+        }
+        if (i >= 24) {
+            return false;
+        }
+        if (d_val > 0) {
+            buffer[i] = (d_val % 10) + '0';
+            d_val /= 10;
+        } else {
+            buffer[i] = '0';
+        }
+        if (i == 6) {
+            i += 1;
+            buffer[i] = '.';
+        }
+        if (i >= 24) {
+            return false;
+        }
+    }
+    for (int j = 0; j < i / 2; j++) {
+        char c = buffer[j];
+        buffer[j] = buffer[i - j - 1];
+        buffer[i - j - 1] = c;
+    }
+    i -= 1;
+    while (buffer[i] == '0') {
+        buffer[i] = 0;
+        i -= 1;
+    }
+    if (buffer[i] == '.') buffer[i] = 0;
+    size_t len = strlen(buffer);
+    if (len >= out_len) {
+        return false;
+    }
+    memcpy(out, buffer, len + 1);
+    return true;
+}
+
+// previous print_uint
+static bool print_uint_digit_loop(uint64_t num, char *out, size_t out_len) {
+    char buffer[21];
+    size_t i, j;
+
+    if (num == 0) {
+        if (out_len < 2) {
+            return false;
+        }
+        memcpy(out, "0", 2);
+        return true;
+    }
+    for (i = 0; num > 0; i++) {
+        buffer[i] = (num % 10) + '0';
+        num /= 10;
+    }
+    if (out_len <= i) {
+        return false;
+    }
+    for (j = 0; j < i; j++) {
+        out[j] = buffer[i - j - 1];
+    }
+    out[i] = '\0';
+    return true;
+}
+
+static bool print_amount_no_asset(uint64_t amount, char *out, size_t out_len) {
+    return print_amount(amount, NULL, NETWORK_TYPE_PUBLIC, out, out_len);
+}
+
+typedef bool (*printer_t)(uint64_t value, char *out, size_t out_len);
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+static double bench_printer(printer_t printer,
+                            const uint64_t *values,
+                            unsigned int iterations,
+                            unsigned int *checksum) {
+    char out[32];
+    *checksum = 0;
+    uint64_t start = now_ns();
+    for (unsigned int i = 0; i < iterations; i++) {
+        printer(values[i % AMOUNTS_COUNT], out, sizeof(out));
+        *checksum = *checksum * 31 + out[i % 8];
+    }
+    return (double) (now_ns() - start) / iterations;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int iterations = DEFAULT_ITERATIONS;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        switch (opt) {
+            case 'n':
+                iterations = strtoul(optarg, NULL, 10);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n iterations]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (iterations == 0) {
+        fprintf(stderr, "iterations must be positive\n");
+        return 1;
+    }
+
+    // typical amounts: a few to a few million units, with or without stroops
+    static uint64_t amounts[AMOUNTS_COUNT];
+    srand(1);
+    for (int i = 0; i < AMOUNTS_COUNT; i++) {
+        uint64_t units = (uint64_t) rand() % 10000000;
+        amounts[i] = units * 10000000 + (i % 2 ? (uint64_t) rand() % 10000000 : 0);
+    }
+
+    const struct {
+        const char *name;
+        printer_t before;
+        printer_t after;
+    } benches[] = {{"print_amount", print_amount_digit_loop, print_amount_no_asset},
+                   {"print_uint", print_uint_digit_loop, print_uint}};
+    printf("function,digit_loop_ns,digit_pairs_ns,speedup\n");
+    for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+        unsigned int expected, checksum;
+        double before = bench_printer(benches[i].before, amounts, iterations, &expected);
+        double after = bench_printer(benches[i].after, amounts, iterations, &checksum);
+        if (checksum != expected) {
+            fprintf(stderr, "%s output mismatch\n", benches[i].name);
+            return 1;
+        }
+        printf("%s,%.1f,%.1f,%.2f\n", benches[i].name, before, after, before / after);
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * Host-side microbenchmark of the base32 encoders on the StrKey payload sizes, printed as CSV.
+ *
+ * usage: bench_base32 [-n iterations]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "common/base32.h"
+
+#define DEFAULT_ITERATIONS 1000000
+
+typedef int (*base32_encoder_t)(const uint8_t *data, int length, uint8_t *result, int buf_size);
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/*
+ * Average time of one encoding of length bytes, the input changes at each iteration so that the
+ * calls can't be hoisted out of the loop.
+ */
+static double bench_encoder(base32_encoder_t encoder, int length, unsigned int iterations) {
+    uint8_t data[128];
+    uint8_t out[256];
+    unsigned int checksum = 0;
+    for (int i = 0; i < length; i++) {
+        data[i] = i * 167 + 13;
+    }
+    uint64_t start = now_ns();
+    for (unsigned int i = 0; i < iterations; i++) {
+        data[i % length] ^= i;
+        checksum += encoder(data, length, out, sizeof(out)) + out[i % length];
+    }
+    uint64_t elapsed = now_ns() - start;
+    if (checksum == 0) {
+        // keep the results alive
+        fprintf(stderr, "checksum 0\n");
+    }
+    return (double) elapsed / iterations;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int iterations = DEFAULT_ITERATIONS;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        switch (opt) {
+            case 'n':
+                iterations = strtoul(optarg, NULL, 10);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n iterations]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (iterations == 0) {
+        fprintf(stderr, "iterations must be positive\n");
+        return 1;
+    }
+
+    // StrKey payloads: account/hash-x/pre-auth-tx keys, muxed accounts, 64 bytes signed payloads
+    const int lengths[] = {35, 43, 103};
+    printf("length,base32_encode_ns,base32_encode_blocks_ns,speedup\n");
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        double generic = bench_encoder(base32_encode, lengths[i], iterations);
+        double blocks = bench_encoder(base32_encode_blocks, lengths[i], iterations);
+        printf("%d,%.1f,%.1f,%.2f\n", lengths[i], generic, blocks, generic / blocks);
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * Host-side microbenchmark of the StrKey CRC16 against the bit by bit implementation it
+ * replaced, printed as CSV. Built twice, with the default nibble table and with
+ * CRC16_BYTE_TABLE.
+ *
+ * usage: bench_crc16 [-n iterations]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "utils.h"
+
+#define DEFAULT_ITERATIONS 1000000
+
+typedef uint16_t (*crc16_t)(const uint8_t *input_str, int num_bytes);
+
+static uint16_t crc16_bitwise(const uint8_t *input_str, int num_bytes) {
+    uint16_t crc = 0;
+    while (--num_bytes >= 0) {
+        crc = crc ^ (uint32_t) *input_str++ << 8;
+        for (int i = 0; i < 8; i++) {
+            crc = crc & 0x8000 ? crc << 1 ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/*
+ * Average time of one checksum of length bytes, the input changes at each iteration so that the
+ * calls can't be hoisted out of the loop.
+ */
+static double bench_crc16(crc16_t crc, int length, unsigned int iterations, uint16_t *checksum) {
+    uint8_t data[128];
+    for (int i = 0; i < length; i++) {
+        data[i] = i * 167 + 13;
+    }
+    *checksum = 0;
+    uint64_t start = now_ns();
+    for (unsigned int i = 0; i < iterations; i++) {
+        data[i % length] ^= i;
+        *checksum ^= crc(data, length);
+    }
+    return (double) (now_ns() - start) / iterations;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int iterations = DEFAULT_ITERATIONS;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        switch (opt) {
+            case 'n':
+                iterations = strtoul(optarg, NULL, 10);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n iterations]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (iterations == 0) {
+        fprintf(stderr, "iterations must be positive\n");
+        return 1;
+    }
+
+    // checksummed StrKey payloads: keys, muxed accounts, 64 bytes signed payloads
+    const int lengths[] = {33, 41, 101};
+    printf("length,bitwise_ns,%s_ns,speedup\n",
+#ifdef CRC16_BYTE_TABLE
+           "byte_table"
+#else
+           "nibble_table"
+#endif
+    );
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        uint16_t expected, checksum;
+        double bitwise = bench_crc16(crc16_bitwise, lengths[i], iterations, &expected);
+        double table = bench_crc16(crc16, lengths[i], iterations, &checksum);
+        if (checksum != expected) {
+            fprintf(stderr, "crc16 mismatch for %d bytes\n", lengths[i]);
+            return 1;
+        }
+        printf("%d,%.1f,%.1f,%.2f\n", lengths[i], bitwise, table, bitwise / table);
+    }
+    return 0;
+}
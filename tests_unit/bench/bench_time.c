@@ -0,0 +1,90 @@
+/*
+ * Host-side microbenchmark of print_time against the gmtime_r and snprintf implementation it
+ * replaced, printed as CSV.
+ *
+ * usage: bench_time [-n iterations]
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "utils.h"
+
+#define DEFAULT_ITERATIONS 1000000
+
+// previous print_time
+static bool print_time_gmtime(uint64_t seconds, char *out, size_t out_len) {
+    if (seconds > 253402300799 || out_len < 20) {
+        return false;
+    }
+    struct tm tm;
+    if (!gmtime_r((time_t *) &seconds, &tm)) {
+        return false;
+    }
+    return snprintf(out,
+                    out_len,
+                    "%04d-%02d-%02d %02d:%02d:%02d",
+                    tm.tm_year + 1900,
+                    tm.tm_mon + 1,
+                    tm.tm_mday,
+                    tm.tm_hour,
+                    tm.tm_min,
+                    tm.tm_sec) > 0;
+}
+
+typedef bool (*printer_t)(uint64_t seconds, char *out, size_t out_len);
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/*
+ * Average time of one timestamp, spread over the years a time bound is likely to hold.
+ */
+static double bench_printer(printer_t printer, unsigned int iterations, unsigned int *checksum) {
+    char out[20];
+    *checksum = 0;
+    uint64_t start = now_ns();
+    for (unsigned int i = 0; i < iterations; i++) {
+        printer(1600000000 + (uint64_t) i * 7919, out, sizeof(out));
+        *checksum = *checksum * 31 + out[i % 19];
+    }
+    return (double) (now_ns() - start) / iterations;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int iterations = DEFAULT_ITERATIONS;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        switch (opt) {
+            case 'n':
+                iterations = strtoul(optarg, NULL, 10);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n iterations]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (iterations == 0) {
+        fprintf(stderr, "iterations must be positive\n");
+        return 1;
+    }
+
+    unsigned int expected, checksum;
+    double before = bench_printer(print_time_gmtime, iterations, &expected);
+    double after = bench_printer(print_time, iterations, &checksum);
+    if (checksum != expected) {
+        fprintf(stderr, "print_time output mismatch\n");
+        return 1;
+    }
+    printf("function,gmtime_snprintf_ns,civil_date_ns,speedup\n");
+    printf("print_time,%.1f,%.1f,%.2f\n", before, after, before / after);
+    return 0;
+}
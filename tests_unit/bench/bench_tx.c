@@ -0,0 +1,330 @@
+/*
+ * Host-side throughput benchmark of the transaction parser and formatter.
+ *
+ * Every .raw testcase is validated with validate_tx_xdr and then walked screen by screen
+ * with set_state_data(true), as the review flow does on the device. Results are printed
+ * as CSV (default) or JSON:
+ *   - per testcase: parse and format time, ns per operation and parsed bytes per second
+ *   - per operation type: percentiles of the cost (parse + format) of a single operation
+ *
+ * usage: bench_tx [-n iterations] [-f csv|json] [testcases_dir]
+ */
+
+#include <dirent.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "transaction/transaction_parser.h"
+#include "transaction/transaction_formatter.h"
+
+#define DEFAULT_ITERATIONS    1000
+#define MAX_TESTCASES         256
+#define MAX_PATH_LENGTH       1024
+
+#define OPERATION_NAMES_ENTRY(id, TYPE, name) [id] = #name,
+
+static const char *OPERATION_NAMES[OPERATION_TYPES_COUNT] = {
+    OPERATION_TYPES(OPERATION_NAMES_ENTRY, OPERATION_NAMES_ENTRY)};
+
+// about the average character width of the device fonts, so that short fields are paired
+unsigned short bagl_compute_line_width(unsigned short font_id,
+                                       unsigned short width,
+                                       const void *text,
+                                       unsigned char text_length,
+                                       unsigned char text_encoding) {
+    (void) font_id;
+    (void) width;
+    (void) text;
+    (void) text_encoding;
+    return 6 * text_length;
+}
+
+typedef struct {
+    char name[128];
+    uint32_t size;
+    uint8_t operations_count;
+    uint32_t screens;
+    uint64_t parse_ns;
+    uint64_t format_ns;
+} testcase_result_t;
+
+typedef struct {
+    uint64_t *ns;
+    size_t count;
+    size_t capacity;
+} samples_t;
+
+// GDUTHCF37UX32EMANXIL2WOOVEDZ47GHBTT3DYKU6EKM37SOIZXM2FN7, same signer as test_tx_formatter
+static const uint8_t PUBLIC_KEY[] = {0xe9, 0x33, 0x88, 0xbb, 0xfd, 0x2f, 0xbd, 0x11,
+                                     0x80, 0x6d, 0xd0, 0xbd, 0x59, 0xce, 0xa9, 0x7,
+                                     0x9e, 0x7c, 0xc7, 0xc,  0xe7, 0xb1, 0xe1, 0x54,
+                                     0xf1, 0x14, 0xcd, 0xfe, 0x4e, 0x46, 0x6e, 0xcd};
+
+static samples_t op_samples[OPERATION_TYPES_COUNT];
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+static void add_sample(samples_t *samples, uint64_t ns) {
+    if (samples->count == samples->capacity) {
+        samples->capacity = samples->capacity ? samples->capacity * 2 : 1024;
+        samples->ns = realloc(samples->ns, samples->capacity * sizeof(uint64_t));
+        if (samples->ns == NULL) {
+            perror("realloc");
+            exit(1);
+        }
+    }
+    samples->ns[samples->count++] = ns;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t percentile(const samples_t *samples, unsigned int p) {
+    return samples->ns[(samples->count - 1) * p / 100];
+}
+
+static bool is_testcase(const char *filename) {
+    size_t len = strlen(filename);
+    return len > 4 && strcmp(filename + len - 4, ".raw") == 0;
+}
+
+static int compare_names(const void *a, const void *b) {
+    return strcmp(*(char *const *) a, *(char *const *) b);
+}
+
+static bool load_transaction_data(const char *path, tx_ctx_t *tx_ctx) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return false;
+    }
+    memset(tx_ctx, 0, sizeof(tx_ctx_t));
+    tx_ctx->raw_size = fread(tx_ctx->raw, 1, RAW_TX_MAX_SIZE, f);
+    fclose(f);
+    return tx_ctx->raw_size != 0;
+}
+
+/*
+ * Walk every screen of the review once. The time spent in each set_state_data call is
+ * accounted to the data index (header or operation) it ends up displaying.
+ */
+static uint32_t walk_screens(uint64_t op_ns[MAX_OPS], uint8_t op_types[MAX_OPS]) {
+    uint8_t op_cnt = G_context.tx_info.tx_details.operations_count;
+    uint32_t screens = 0;
+    uint64_t start;
+
+    G_ui_current_data_index = 0;
+    formatter_index = 0;
+    explicit_bzero(formatter_stack, sizeof(formatter_stack));
+    // measure the formatters, not copies of the screens rendered by the previous walk
+    reset_rendered_screens();
+
+    bool more = true;
+    while (more) {
+        start = now_ns();
+        set_state_data(true);
+        if (G_ui_current_data_index >= 2) {
+            op_ns[G_ui_current_data_index - 2] += now_ns() - start;
+            op_types[G_ui_current_data_index - 2] = G_context.tx_info.tx_details.op_details.type;
+        }
+        screens++;
+
+        formatter_index++;
+        more = formatter_stack[formatter_index] != NULL ||
+               (op_cnt != 0 && G_ui_current_data_index < op_cnt);
+        if (more && formatter_stack[formatter_index] == NULL) {
+            // unreachable for a well-formed review, avoid spinning forever
+            fprintf(stderr, "formatter chain ended before the last operation\n");
+            exit(1);
+        }
+    }
+    return screens;
+}
+
+static bool bench_testcase(const char *path, unsigned int iterations, testcase_result_t *result) {
+    if (!load_transaction_data(path, &G_context.tx_info)) {
+        return false;
+    }
+    memcpy(G_context.raw_public_key, PUBLIC_KEY, sizeof(PUBLIC_KEY));
+    result->size = G_context.tx_info.raw_size;
+
+    for (unsigned int i = 0; i < iterations; i++) {
+        uint64_t op_ns[MAX_OPS] = {0};
+        uint8_t op_types[MAX_OPS] = {0};
+
+        uint64_t start = now_ns();
+        if (!validate_tx_xdr(G_context.tx_info.raw, G_context.tx_info.raw_size, &G_context.tx_info)) {
+            return false;
+        }
+        uint64_t parsed = now_ns();
+        result->screens = walk_screens(op_ns, op_types);
+        uint64_t formatted = now_ns();
+
+        result->parse_ns += parsed - start;
+        result->format_ns += formatted - parsed;
+        result->operations_count = G_context.tx_info.tx_details.operations_count;
+        for (uint8_t op = 0; op < result->operations_count; op++) {
+            add_sample(&op_samples[op_types[op]], op_ns[op]);
+        }
+    }
+    return true;
+}
+
+static void print_csv(const testcase_result_t *results, size_t count, unsigned int iterations) {
+    printf("testcase,size,operations,screens,parse_ns,format_ns,ns_per_op,parse_bytes_per_s\n");
+    for (size_t i = 0; i < count; i++) {
+        const testcase_result_t *r = &results[i];
+        uint64_t total_ns = (r->parse_ns + r->format_ns) / iterations;
+        printf("%s,%u,%u,%u,%llu,%llu,%llu,%.0f\n",
+               r->name,
+               r->size,
+               r->operations_count,
+               r->screens,
+               (unsigned long long) (r->parse_ns / iterations),
+               (unsigned long long) (r->format_ns / iterations),
+               (unsigned long long) (total_ns / r->operations_count),
+               (double) r->size * iterations * 1e9 / (double) (r->parse_ns ? r->parse_ns : 1));
+    }
+
+    printf("\noperation,samples,p50_ns,p90_ns,p99_ns,max_ns\n");
+    for (int type = 0; type < OPERATION_TYPES_COUNT; type++) {
+        samples_t *s = &op_samples[type];
+        if (s->count == 0) {
+            continue;
+        }
+        printf("%s,%zu,%llu,%llu,%llu,%llu\n",
+               OPERATION_NAMES[type],
+               s->count,
+               (unsigned long long) percentile(s, 50),
+               (unsigned long long) percentile(s, 90),
+               (unsigned long long) percentile(s, 99),
+               (unsigned long long) percentile(s, 100));
+    }
+}
+
+static void print_json(const testcase_result_t *results, size_t count, unsigned int iterations) {
+    printf("{\n  \"iterations\": %u,\n  \"testcases\": [\n", iterations);
+    for (size_t i = 0; i < count; i++) {
+        const testcase_result_t *r = &results[i];
+        uint64_t total_ns = (r->parse_ns + r->format_ns) / iterations;
+        printf(
+            "    {\"name\": \"%s\", \"size\": %u, \"operations\": %u, \"screens\": %u, "
+            "\"parse_ns\": %llu, \"format_ns\": %llu, \"ns_per_op\": %llu, "
+            "\"parse_bytes_per_s\": %.0f}%s\n",
+            r->name,
+            r->size,
+            r->operations_count,
+            r->screens,
+            (unsigned long long) (r->parse_ns / iterations),
+            (unsigned long long) (r->format_ns / iterations),
+            (unsigned long long) (total_ns / r->operations_count),
+            (double) r->size * iterations * 1e9 / (double) (r->parse_ns ? r->parse_ns : 1),
+            i + 1 < count ? "," : "");
+    }
+    printf("  ],\n  \"operations\": [\n");
+    bool first = true;
+    for (int type = 0; type < OPERATION_TYPES_COUNT; type++) {
+        samples_t *s = &op_samples[type];
+        if (s->count == 0) {
+            continue;
+        }
+        printf(
+            "%s    {\"name\": \"%s\", \"samples\": %zu, \"p50_ns\": %llu, \"p90_ns\": %llu, "
+            "\"p99_ns\": %llu, \"max_ns\": %llu}",
+            first ? "" : ",\n",
+            OPERATION_NAMES[type],
+            s->count,
+            (unsigned long long) percentile(s, 50),
+            (unsigned long long) percentile(s, 90),
+            (unsigned long long) percentile(s, 99),
+            (unsigned long long) percentile(s, 100));
+        first = false;
+    }
+    printf("\n  ]\n}\n");
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int iterations = DEFAULT_ITERATIONS;
+    bool json = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:f:")) != -1) {
+        switch (opt) {
+            case 'n':
+                iterations = strtoul(optarg, NULL, 10);
+                break;
+            case 'f':
+                json = strcmp(optarg, "json") == 0;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n iterations] [-f csv|json] [testcases_dir]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (iterations == 0) {
+        fprintf(stderr, "iterations must be positive\n");
+        return 1;
+    }
+    const char *dirname = optind < argc ? argv[optind] : TESTCASES_DIR;
+
+    DIR *dir = opendir(dirname);
+    if (dir == NULL) {
+        perror(dirname);
+        return 1;
+    }
+    char *names[MAX_TESTCASES];
+    size_t count = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL && count < MAX_TESTCASES) {
+        if (is_testcase(entry->d_name)) {
+            names[count++] = strdup(entry->d_name);
+        }
+    }
+    closedir(dir);
+    qsort(names, count, sizeof(char *), compare_names);
+
+    testcase_result_t *results = calloc(count, sizeof(testcase_result_t));
+    size_t done = 0;
+    for (size_t i = 0; i < count; i++) {
+        char path[MAX_PATH_LENGTH];
+        snprintf(path, sizeof(path), "%s/%s", dirname, names[i]);
+        testcase_result_t *r = &results[done];
+        snprintf(r->name, sizeof(r->name), "%.*s", (int) strlen(names[i]) - 4, names[i]);
+        if (bench_testcase(path, iterations, r)) {
+            done++;
+        } else {
+            fprintf(stderr, "skipping %s: parse failed\n", path);
+            memset(r, 0, sizeof(testcase_result_t));
+        }
+        free(names[i]);
+    }
+
+    for (int type = 0; type < OPERATION_TYPES_COUNT; type++) {
+        if (op_samples[type].count) {
+            qsort(op_samples[type].ns, op_samples[type].count, sizeof(uint64_t), compare_u64);
+        }
+    }
+
+    if (json) {
+        print_json(results, done, iterations);
+    } else {
+        print_csv(results, done, iterations);
+    }
+
+    free(results);
+    for (int type = 0; type < OPERATION_TYPES_COUNT; type++) {
+        free(op_samples[type].ns);
+    }
+    return 0;
+}
@@ -6,3 +6,8 @@
         printf("error: %d", code); \
     } while (0)
 #define PIC(code) code
+// THROW doesn't jump, the blocks run in order
+#define BEGIN_TRY
+#define TRY
+#define FINALLY
+#define END_TRY
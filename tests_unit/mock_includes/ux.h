@@ -10,3 +10,14 @@ struct ux_state_s {
 };
 
 typedef struct ux_state_s ux_state_t;
+
+#define BAGL_FONT_OPEN_SANS_EXTRABOLD_11px 0
+#define BAGL_FONT_OPEN_SANS_REGULAR_11px   1
+#define BAGL_ENCODING_LATIN1               0
+
+// width in pixels of a line of text, provided by each test using it
+unsigned short bagl_compute_line_width(unsigned short font_id,
+                                       unsigned short width,
+                                       const void *text,
+                                       unsigned char text_length,
+                                       unsigned char text_encoding);
@@ -0,0 +1,60 @@
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "../src/apdu/apdu_parser.h"
+
+static void test_apdu_parser_short(void **state) {
+    (void) state;
+
+    command_t cmd;
+    uint8_t apdu[] = {0xE0, 0x04, 0x80, 0x00, 0x03, 0x01, 0x02, 0x03};
+
+    assert_true(apdu_parser(&cmd, apdu, sizeof(apdu)));
+    assert_int_equal(cmd.cla, 0xE0);
+    assert_int_equal(cmd.ins, INS_SIGN_TX);
+    assert_int_equal(cmd.p1, 0x80);
+    assert_int_equal(cmd.p2, 0x00);
+    assert_int_equal(cmd.lc, 3);
+    assert_true(cmd.data == apdu + 5);
+
+    uint8_t empty[] = {0xE0, 0x06, 0x00, 0x00, 0x00};
+    assert_true(apdu_parser(&cmd, empty, sizeof(empty)));
+    assert_int_equal(cmd.lc, 0);
+    assert_true(cmd.data == NULL);
+
+    // Lc doesn't match the length of the command data
+    assert_false(apdu_parser(&cmd, apdu, sizeof(apdu) - 1));
+    assert_false(apdu_parser(&cmd, apdu, 4));
+}
+
+static void test_apdu_parser_extended(void **state) {
+    (void) state;
+
+    command_t cmd;
+    uint8_t apdu[7 + 1024] = {0xE0, 0x04, 0x00, 0x80, 0x00, 0x04, 0x00};
+
+    assert_true(apdu_parser(&cmd, apdu, sizeof(apdu)));
+    assert_int_equal(cmd.ins, INS_SIGN_TX);
+    assert_int_equal(cmd.p2, 0x80);
+    assert_int_equal(cmd.lc, 1024);
+    assert_true(cmd.data == apdu + 7);
+
+    // extended Lc is truncated, zero or doesn't match the length of the command data
+    assert_false(apdu_parser(&cmd, apdu, 6));
+    assert_false(apdu_parser(&cmd, apdu, sizeof(apdu) - 1));
+    uint8_t zero[] = {0xE0, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00};
+    assert_false(apdu_parser(&cmd, zero, sizeof(zero)));
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_apdu_parser_short),
+        cmocka_unit_test(test_apdu_parser_extended),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
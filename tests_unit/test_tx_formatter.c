@@ -9,6 +9,25 @@
 
 #include "transaction/transaction_parser.h"
 #include "transaction/transaction_formatter.h"
+#include "transaction/transaction_summary.h"
+#include "settings.h"
+
+/* a character wider than a line pairs no screen, as in the expected results of the testcases */
+#define NO_PAIRING_CHAR_WIDTH 200
+
+static unsigned short char_width = NO_PAIRING_CHAR_WIDTH;
+
+unsigned short bagl_compute_line_width(unsigned short font_id,
+                                       unsigned short width,
+                                       const void *text,
+                                       unsigned char text_length,
+                                       unsigned char text_encoding) {
+    (void) font_id;
+    (void) width;
+    (void) text;
+    (void) text_encoding;
+    return char_width * text_length;
+}
 
 static const char *testcases[] = {
     "../testcases/opCreateAccount.raw",
@@ -143,7 +162,10 @@ static void get_result_filename(const char *filename, char *path, size_t size) {
 static void check_transaction_results(const char *filename) {
     char path[1024];
     char line[4096];
+    char previous_title[DETAIL_CAPTION_MAX_LENGTH] = {0};
+    char previous_value[DETAIL_VALUE_MAX_LENGTH] = {0};
     uint8_t op_cnt = G_context.tx_info.tx_details.operations_count;
+    uint16_t screens = 0;
     G_ui_current_data_index = 0;
     get_result_filename(filename, path, sizeof(path));
 
@@ -170,6 +192,31 @@ static void check_transaction_results(const char *filename) {
         }
         assert_string_equal(expected_title, G_ui_detail_caption);
         assert_string_equal(expected_value, G_ui_detail_value);
+        assert_int_equal(get_screen_position(), screens);
+        screens++;
+
+        // rendering the next screen ahead doesn't change the displayed one
+        prerender_next_screen();
+        assert_string_equal(expected_title, G_ui_detail_caption);
+        assert_string_equal(expected_value, G_ui_detail_value);
+
+        // back and forth within an item, from the rendered screens or formatted again
+        if (formatter_index > 0) {
+            char caption[DETAIL_CAPTION_MAX_LENGTH];
+            char value[DETAIL_VALUE_MAX_LENGTH];
+            memcpy(caption, G_ui_detail_caption, sizeof(caption));
+            memcpy(value, G_ui_detail_value, sizeof(value));
+            formatter_index--;
+            set_state_data(false);
+            assert_string_equal(previous_title, G_ui_detail_caption);
+            assert_string_equal(previous_value, G_ui_detail_value);
+            formatter_index++;
+            set_state_data(true);
+            assert_string_equal(caption, G_ui_detail_caption);
+            assert_string_equal(value, G_ui_detail_value);
+        }
+        memcpy(previous_title, G_ui_detail_caption, sizeof(previous_title));
+        memcpy(previous_value, G_ui_detail_value, sizeof(previous_value));
 
         formatter_index++;
 
@@ -179,6 +226,7 @@ static void check_transaction_results(const char *filename) {
     }
     assert_int_equal(fgets(line, sizeof(line), fp), 0);
     assert_int_equal(feof(fp), 1);
+    assert_int_equal(screens, G_context.tx_info.screens_count);
     fclose(fp);
 }
 
@@ -194,6 +242,7 @@ static void test_tx(const char *filename) {
     assert_true(
         parse_tx_xdr(G_context.tx_info.raw, G_context.tx_info.raw_size, &G_context.tx_info));
     memcpy(G_context.raw_public_key, public_key, sizeof(public_key));
+    assert_true(count_screens());
 
     check_transaction_results(filename);
 }
@@ -206,9 +255,212 @@ void test_transactions(void **state) {
     }
 }
 
+void test_summary(void **state) {
+    (void) state;
+    static const char *expected[][2] = {
+        // transaction details
+        {"Memo Text", "hello world"},
+        {"Max Fee", "0.00001 XLM"},
+        {"Sequence Num", "103720918407102568"},
+        {"Valid Before (UTC)", "2022-12-12 04:12:12"},
+        {"Tx Source", "GDUTHC..XM2FN7"},
+        // summary of the operations
+        {"Operations", "1"},
+        {"Operation Types", "Payment: 1"},
+        {"Total Sent", "922,337,203,685.4775807 XLM"},
+        {"Largest Amount", "922,337,203,685.4775807 XLM"},
+        {"Recipient 1 of 1", "GDRMNAIPTNIJWJSL6JOF76CJORN47TDVMWERTXO2G2WKOMXGNHUFL5QX"},
+    };
+    // GDUTHCF37UX32EMANXIL2WOOVEDZ47GHBTT3DYKU6EKM37SOIZXM2FN7
+    uint8_t public_key[] = {0xe9, 0x33, 0x88, 0xbb, 0xfd, 0x2f, 0xbd, 0x11, 0x80, 0x6d, 0xd0,
+                            0xbd, 0x59, 0xce, 0xa9, 0x7,  0x9e, 0x7c, 0xc7, 0xc,  0xe7, 0xb1,
+                            0xe1, 0x54, 0xf1, 0x14, 0xcd, 0xfe, 0x4e, 0x46, 0x6e, 0xcd};
+    tx_ctx_t *tx_ctx = &G_context.tx_info;
+    uint8_t tx_screens = 5;
+    char caption[DETAIL_CAPTION_MAX_LENGTH];
+    char value[DETAIL_VALUE_MAX_LENGTH];
+
+    memset(tx_ctx, 0, sizeof(*tx_ctx));
+    load_transaction_data("../testcases/opPaymentAssetNative.raw", tx_ctx);
+    assert_true(validate_tx_xdr(tx_ctx->raw, tx_ctx->raw_size, tx_ctx));
+    memcpy(G_context.raw_public_key, public_key, sizeof(public_key));
+    assert_true(count_screens());
+    assert_true(summarize_tx(tx_ctx));
+    assert_int_equal(tx_ctx->tx_details.operation_index, 1);
+
+    for (uint8_t i = 0; i < tx_screens; i++) {
+        assert_true(render_tx_details_screen(i));
+        assert_string_equal(G_ui_detail_caption, expected[i][0]);
+        assert_string_equal(G_ui_detail_value, expected[i][1]);
+    }
+    assert_false(render_tx_details_screen(tx_screens));
+
+    for (uint8_t i = tx_screens; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        assert_true(
+            format_summary(tx_ctx, i - tx_screens, caption, sizeof(caption), value, sizeof(value)));
+        assert_string_equal(caption, expected[i][0]);
+        assert_string_equal(value, expected[i][1]);
+    }
+    assert_false(format_summary(tx_ctx,
+                                sizeof(expected) / sizeof(expected[0]) - tx_screens,
+                                caption,
+                                sizeof(caption),
+                                value,
+                                sizeof(value)));
+}
+
+void test_summary_not_payments(void **state) {
+    (void) state;
+    tx_ctx_t *tx_ctx = &G_context.tx_info;
+
+    // the set options operation isn't covered by the summary, its details are always reviewed
+    memset(tx_ctx, 0, sizeof(*tx_ctx));
+    load_transaction_data("../testcases/txMultiOperations.raw", tx_ctx);
+    assert_true(validate_tx_xdr(tx_ctx->raw, tx_ctx->raw_size, tx_ctx));
+    assert_false(summarize_tx(tx_ctx));
+}
+
+// Walk the whole review of a transaction, a NULL expected value isn't checked
+void test_summary_total_too_large(void **state) {
+    (void) state;
+    // two payments of 900,000,000,000 BTC, each one printable but not their total
+    static const uint8_t raw[] = {
+        0x7a, 0xc3, 0x39, 0x97, 0x54, 0x4e, 0x31, 0x75, 0xd2, 0x66, 0xbd, 0x02,
+        0x24, 0x39, 0xb2, 0x2c, 0xdb, 0x16, 0x50, 0x8c, 0x01, 0x16, 0x3f, 0x26,
+        0xe5, 0xcb, 0x2a, 0x3e, 0x10, 0x45, 0xa9, 0x79, 0x00, 0x00, 0x00, 0x02,
+        0x00, 0x00, 0x00, 0x00, 0xe9, 0x33, 0x88, 0xbb, 0xfd, 0x2f, 0xbd, 0x11,
+        0x80, 0x6d, 0xd0, 0xbd, 0x59, 0xce, 0xa9, 0x07, 0x9e, 0x7c, 0xc7, 0x0c,
+        0xe7, 0xb1, 0xe1, 0x54, 0xf1, 0x14, 0xcd, 0xfe, 0x4e, 0x46, 0x6e, 0xcd,
+        0x00, 0x00, 0x00, 0xc8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+        0xe2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x42, 0x54, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe2, 0xc6, 0x81, 0x0f,
+        0x9b, 0x50, 0x9b, 0x26, 0x4b, 0xf2, 0x5c, 0x5f, 0xf8, 0x49, 0x74, 0x5b,
+        0xcf, 0xcc, 0x75, 0x65, 0x89, 0x19, 0xdd, 0xda, 0x36, 0xac, 0xa7, 0x32,
+        0xe6, 0x69, 0xe8, 0x55, 0x7c, 0xe6, 0x6c, 0x50, 0xe2, 0x84, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+        0xe2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x42, 0x54, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe2, 0xc6, 0x81, 0x0f,
+        0x9b, 0x50, 0x9b, 0x26, 0x4b, 0xf2, 0x5c, 0x5f, 0xf8, 0x49, 0x74, 0x5b,
+        0xcf, 0xcc, 0x75, 0x65, 0x89, 0x19, 0xdd, 0xda, 0x36, 0xac, 0xa7, 0x32,
+        0xe6, 0x69, 0xe8, 0x55, 0x7c, 0xe6, 0x6c, 0x50, 0xe2, 0x84, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+    };
+    tx_ctx_t *tx_ctx = &G_context.tx_info;
+
+    memset(tx_ctx, 0, sizeof(*tx_ctx));
+    memcpy(tx_ctx->raw, raw, sizeof(raw));
+    tx_ctx->raw_size = sizeof(raw);
+    assert_true(validate_tx_xdr(tx_ctx->raw, tx_ctx->raw_size, tx_ctx));
+    assert_false(summarize_tx(tx_ctx));
+}
+
+static void check_review(const char *filename, const char *const expected[][2], uint8_t count) {
+    // GDUTHCF37UX32EMANXIL2WOOVEDZ47GHBTT3DYKU6EKM37SOIZXM2FN7
+    uint8_t public_key[] = {0xe9, 0x33, 0x88, 0xbb, 0xfd, 0x2f, 0xbd, 0x11, 0x80, 0x6d, 0xd0,
+                            0xbd, 0x59, 0xce, 0xa9, 0x7,  0x9e, 0x7c, 0xc7, 0xc,  0xe7, 0xb1,
+                            0xe1, 0x54, 0xf1, 0x14, 0xcd, 0xfe, 0x4e, 0x46, 0x6e, 0xcd};
+    tx_ctx_t *tx_ctx = &G_context.tx_info;
+    uint8_t screens = 0;
+
+    memset(tx_ctx, 0, sizeof(*tx_ctx));
+    load_transaction_data(filename, tx_ctx);
+    assert_true(parse_tx_xdr(tx_ctx->raw, tx_ctx->raw_size, tx_ctx));
+    memcpy(G_context.raw_public_key, public_key, sizeof(public_key));
+    assert_true(count_screens());
+    assert_int_equal(tx_ctx->screens_count, count);
+
+    set_state_data(true);
+    while (formatter_stack[formatter_index] != NULL) {
+        assert_true(screens < count);
+        assert_string_equal(G_ui_detail_caption, expected[screens][0]);
+        if (expected[screens][1] != NULL) {
+            assert_string_equal(G_ui_detail_value, expected[screens][1]);
+        }
+        screens++;
+        formatter_index++;
+        if (formatter_stack[formatter_index] == NULL) {
+            break;
+        }
+        set_state_data(true);
+    }
+    assert_int_equal(screens, count);
+}
+
+void test_verbosity(void **state) {
+    (void) state;
+    // a payment from the signer at the base fee, on the public network which is never shown
+    static const char *const full[][2] = {{"Memo Text", NULL},
+                                          {"Max Fee", NULL},
+                                          {"Sequence Num", NULL},
+                                          {"Valid Before (UTC)", NULL},
+                                          {"Tx Source", NULL},
+                                          {"Send", NULL},
+                                          {"Destination", NULL},
+                                          {"Op Source", NULL}};
+    static const char *const standard[][2] = {{"Memo Text", NULL},
+                                              {"Max Fee", NULL},
+                                              {"Sequence Num", NULL},
+                                              {"Valid Before (UTC)", NULL},
+                                              {"Send", NULL},
+                                              {"Destination", NULL}};
+    static const char *const compact[][2] = {{"Memo Text", NULL},
+                                             {"Sequence Num", NULL},
+                                             {"Valid Before (UTC)", NULL},
+                                             {"Send", NULL},
+                                             {"Destination", NULL}};
+    const char *filename = "../testcases/opPaymentAssetNative.raw";
+
+    verbosity_profile = VERBOSITY_FULL;
+    check_review(filename, full, sizeof(full) / sizeof(full[0]));
+    verbosity_profile = VERBOSITY_STANDARD;
+    check_review(filename, standard, sizeof(standard) / sizeof(standard[0]));
+    verbosity_profile = VERBOSITY_COMPACT;
+    check_review(filename, compact, sizeof(compact) / sizeof(compact[0]));
+    verbosity_profile = VERBOSITY_FULL;
+}
+
+void test_paired_screens(void **state) {
+    (void) state;
+    // only the master weight and the low threshold fit on one line each
+    static const char *const expected[][2] = {
+        {"Memo Text", "hello world"},
+        {"Max Fee", "0.00001 XLM"},
+        {"Sequence Num", "103720918407102568"},
+        {"Valid Before (UTC)", "2022-12-12 04:12:12"},
+        {"Tx Source", "GDUTHC..XM2FN7"},
+        {"Operation Type", "Set Options"},
+        {"Inflation Dest", "GDRMNAIPTNIJWJSL6JOF76CJORN47TDVMWERTXO2G2WKOMXGNHUFL5QX"},
+        {"Clear Flags", "AUTH_CLAWBACK_ENABLED"},
+        {"Set Flags", "AUTH_REQUIRED"},
+        {"Master Weight: 255", "Low Threshold: 10"},
+        {"Medium Threshold", "20"},
+        {"High Threshold", "30"},
+        {"Home Domain", "stellar.org"},
+        {"Add Signer", "Type Public Key"},
+        {"Signer Key", "GCJBZJSKICFGD3FJMN5RBQIIXYUNVWOI7YAHQZQKK4UAWFGW6TRBRVX3"},
+        {"Weight", "10"},
+        {"Op Source", "GDUTHC..XM2FN7"},
+    };
+
+    char_width = 6;
+    check_review("../testcases/opSetOptions.raw", expected, sizeof(expected) / sizeof(expected[0]));
+    char_width = NO_PAIRING_CHAR_WIDTH;
+}
+
 int main() {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_transactions),
+        cmocka_unit_test(test_summary),
+        cmocka_unit_test(test_summary_not_payments),
+        cmocka_unit_test(test_summary_total_too_large),
+        cmocka_unit_test(test_verbosity),
+        cmocka_unit_test(test_paired_screens),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
@@ -139,7 +139,131 @@ void test_parse() {
     }
 }
 
+static void seek_tx(const char *filename) {
+    FILE *f = fopen(filename, "rb");
+    assert_non_null(f);
+    tx_ctx_t tx_info;
+    memset(&tx_info, 0, sizeof(tx_ctx_t));
+    tx_info.raw_size = fread(tx_info.raw, 1, RAW_TX_MAX_SIZE, f);
+    fclose(f);
+
+    uint8_t op_types[MAX_OPS];
+    do {
+        assert_true(parse_tx_xdr(tx_info.raw, tx_info.raw_size, &tx_info));
+        op_types[tx_info.tx_details.operation_index - 1] = tx_info.tx_details.op_details.type;
+    } while (tx_info.tx_details.operation_index < tx_info.tx_details.operations_count);
+
+    for (int i = tx_info.tx_details.operations_count - 1; i >= 0; i--) {
+        assert_int_not_equal(tx_info.op_offsets[i], 0);
+        assert_true(parse_tx_xdr_operation(tx_info.raw, tx_info.raw_size, &tx_info, i));
+        assert_int_equal(tx_info.tx_details.operation_index, i + 1);
+        assert_int_equal(tx_info.tx_details.op_details.type, op_types[i]);
+    }
+    assert_false(parse_tx_xdr_operation(tx_info.raw,
+                                        tx_info.raw_size,
+                                        &tx_info,
+                                        tx_info.tx_details.operations_count));
+}
+
+void test_seek_operation() {
+    for (int i = 0; i < sizeof(testcases) / sizeof(testcases[0]); i++) {
+        seek_tx(testcases[i]);
+    }
+}
+
+static void validate_tx(const char *filename) {
+    FILE *f = fopen(filename, "rb");
+    assert_non_null(f);
+    tx_ctx_t tx_info;
+    memset(&tx_info, 0, sizeof(tx_ctx_t));
+    tx_info.raw_size = fread(tx_info.raw, 1, RAW_TX_MAX_SIZE, f);
+    fclose(f);
+
+    if (!validate_tx_xdr(tx_info.raw, tx_info.raw_size, &tx_info)) {
+        fail_msg("validate %s failed!", filename);
+    }
+    assert_int_equal(tx_info.tx_details.operation_index, 1);
+    uint8_t ops_count = 0;
+    for (int i = 0; i < OPERATION_TYPES_COUNT; i++) {
+        ops_count += tx_info.op_type_counts[i];
+    }
+    assert_int_equal(ops_count, tx_info.tx_details.operations_count);
+
+    // truncated or followed by garbage
+    assert_false(validate_tx_xdr(tx_info.raw, tx_info.raw_size - 1, &tx_info));
+    assert_false(validate_tx_xdr(tx_info.raw, tx_info.raw_size + 4, &tx_info));
+}
+
+void test_validate() {
+    for (int i = 0; i < sizeof(testcases) / sizeof(testcases[0]); i++) {
+        validate_tx(testcases[i]);
+    }
+}
+
+static void stream_tx(const char *filename) {
+    FILE *f = fopen(filename, "rb");
+    assert_non_null(f);
+    tx_ctx_t expected;
+    memset(&expected, 0, sizeof(tx_ctx_t));
+    expected.raw_size = fread(expected.raw, 1, RAW_TX_MAX_SIZE, f);
+    fclose(f);
+    assert_true(validate_tx_xdr(expected.raw, expected.raw_size, &expected));
+
+    // chunks as small as BLE segments, the last one completing the envelope
+    tx_ctx_t tx_info;
+    memset(&tx_info, 0, sizeof(tx_ctx_t));
+    memcpy(tx_info.raw, expected.raw, expected.raw_size);
+    for (size_t size = 32; size < expected.raw_size + 32; size += 32) {
+        size_t received = size < expected.raw_size ? size : expected.raw_size;
+        parse_tx_xdr_prefix(tx_info.raw, received, &tx_info);
+        assert_true(tx_info.parsed_ops_count <= expected.tx_details.operations_count);
+    }
+    assert_int_equal(tx_info.parsed_ops_count, expected.tx_details.operations_count);
+
+    if (!validate_tx_xdr(tx_info.raw, expected.raw_size, &tx_info)) {
+        fail_msg("validate %s after streaming failed!", filename);
+    }
+    assert_int_equal(tx_info.parsed_ops_count, 0);
+    assert_int_equal(tx_info.offset, expected.offset);
+    assert_memory_equal(tx_info.op_offsets, expected.op_offsets, sizeof(expected.op_offsets));
+    assert_memory_equal(tx_info.op_type_counts,
+                        expected.op_type_counts,
+                        sizeof(expected.op_type_counts));
+}
+
+void test_stream() {
+    for (int i = 0; i < sizeof(testcases) / sizeof(testcases[0]); i++) {
+        stream_tx(testcases[i]);
+    }
+}
+
+void test_unknown_operation_type() {
+    FILE *f = fopen(testcases[0], "rb");
+    assert_non_null(f);
+    tx_ctx_t tx_info;
+    memset(&tx_info, 0, sizeof(tx_ctx_t));
+    tx_info.raw_size = fread(tx_info.raw, 1, RAW_TX_MAX_SIZE, f);
+    fclose(f);
+    assert_true(validate_tx_xdr(tx_info.raw, tx_info.raw_size, &tx_info));
+
+    // the type of the first operation follows its optional ed25519 or muxed source account
+    uint8_t *op = tx_info.raw + tx_info.op_offsets[0] + 4;
+    if (op[-1] != 0) {
+        op += op[2] == 0 ? 4 + 32 : 4 + 8 + 32;
+    }
+    assert_int_equal(op[3], OPERATION_TYPE_CREATE_ACCOUNT);
+    const uint8_t unknown_types[][4] = {{0, 0, 0, OPERATION_TYPES_COUNT}, {0, 0, 1, 0}};
+    for (size_t i = 0; i < sizeof(unknown_types) / sizeof(unknown_types[0]); i++) {
+        memcpy(op, unknown_types[i], 4);
+        assert_false(validate_tx_xdr(tx_info.raw, tx_info.raw_size, &tx_info));
+    }
+}
+
 int main() {
-    const struct CMUnitTest tests[] = {cmocka_unit_test(test_parse)};
+    const struct CMUnitTest tests[] = {cmocka_unit_test(test_parse),
+                                       cmocka_unit_test(test_seek_operation),
+                                       cmocka_unit_test(test_validate),
+                                       cmocka_unit_test(test_stream),
+                                       cmocka_unit_test(test_unknown_operation_type)};
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
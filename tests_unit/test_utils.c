@@ -2,10 +2,15 @@
 #include <stddef.h>
 #include <setjmp.h>
 #include <stdint.h>
+#include <inttypes.h>
+#include <stdio.h>
 #include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <cmocka.h>
 
+#include "common/base32.h"
 #include "common/base58.h"
 #include "utils.h"
 #include "types.h"
@@ -21,6 +26,43 @@ static void test_encode_ed25519_public_key() {
     assert_string_equal(out, encoded_key);
 }
 
+static void test_encode_key_cached() {
+    uint8_t raw_key[] = {0xe9, 0x33, 0x88, 0xbb, 0xfd, 0x2f, 0xbd, 0x11, 0x80, 0x6d, 0xd0,
+                         0xbd, 0x59, 0xce, 0xa9, 0x7,  0x9e, 0x7c, 0xc7, 0xc,  0xe7, 0xb1,
+                         0xe1, 0x54, 0xf1, 0x14, 0xcd, 0xfe, 0x4e, 0x46, 0x6e, 0xcd};
+    char out[ENCODED_ED25519_PUBLIC_KEY_LENGTH];
+    strkey_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    set_strkey_cache(&cache);
+
+    assert_true(encode_ed25519_public_key(raw_key, out, sizeof(out)));
+    assert_string_equal(out, "GDUTHCF37UX32EMANXIL2WOOVEDZ47GHBTT3DYKU6EKM37SOIZXM2FN7");
+    assert_int_equal(cache.next, 1);
+    assert_int_equal(cache.entries[0].version_byte, VERSION_BYTE_ED25519_PUBLIC_KEY);
+
+    // hit: served from the cache, nothing added
+    cache.entries[0].encoded[0] = 'X';
+    assert_true(encode_ed25519_public_key(raw_key, out, sizeof(out)));
+    assert_string_equal(out, "XDUTHCF37UX32EMANXIL2WOOVEDZ47GHBTT3DYKU6EKM37SOIZXM2FN7");
+    assert_int_equal(cache.next, 1);
+
+    // same key, other version byte: miss
+    assert_true(encode_hash_x_key(raw_key, out, sizeof(out)));
+    assert_string_equal(out, "XDUTHCF37UX32EMANXIL2WOOVEDZ47GHBTT3DYKU6EKM37SOIZXM242X");
+    assert_int_equal(cache.next, 2 % STRKEY_CACHE_SIZE);
+
+    // oldest entry replaced once the cache is full
+    for (int i = 0; i < STRKEY_CACHE_SIZE; i++) {
+        raw_key[0] = i;
+        assert_true(encode_pre_auth_x_key(raw_key, out, sizeof(out)));
+    }
+    for (int i = 0; i < STRKEY_CACHE_SIZE; i++) {
+        assert_int_equal(cache.entries[i].version_byte, VERSION_BYTE_PRE_AUTH_TX_KEY);
+    }
+
+    set_strkey_cache(NULL);
+}
+
 static void test_encode_hash_x_key() {
     uint8_t raw_key[] = {0xe9, 0x33, 0x88, 0xbb, 0xfd, 0x2f, 0xbd, 0x11, 0x80, 0x6d, 0xd0,
                          0xbd, 0x59, 0xce, 0xa9, 0x7,  0x9e, 0x7c, 0xc7, 0xc,  0xe7, 0xb1,
@@ -190,6 +232,41 @@ void test_print_time() {
     assert_false(print_time(18446744073709551615, out, sizeof(out)));
 }
 
+void test_print_time_every_day() {
+    char out[20];
+    char expected[64];
+    struct tm tm;
+    // every day of the valid range, at a different time of day each
+    for (uint64_t day = 0; day <= 2932896; day++) {
+        time_t seconds = day * 86400 + day * 7919 % 86400;
+        assert_non_null(gmtime_r(&seconds, &tm));
+        snprintf(expected,
+                 sizeof(expected),
+                 "%04d-%02d-%02d %02d:%02d:%02d",
+                 tm.tm_year + 1900,
+                 tm.tm_mon + 1,
+                 tm.tm_mday,
+                 tm.tm_hour,
+                 tm.tm_min,
+                 tm.tm_sec);
+        assert_true(print_time(seconds, out, sizeof(out)));
+        assert_string_equal(out, expected);
+    }
+    // every second of a day
+    for (time_t seconds = 951782400; seconds < 951782400 + 86400; seconds++) {
+        assert_non_null(gmtime_r(&seconds, &tm));
+        snprintf(expected,
+                 sizeof(expected),
+                 "2000-02-29 %02d:%02d:%02d",
+                 tm.tm_hour,
+                 tm.tm_min,
+                 tm.tm_sec);
+        assert_true(print_time(seconds, out, sizeof(out)));
+        assert_string_equal(out, expected);
+    }
+    assert_false(print_time(0, out, sizeof(out) - 1));
+}
+
 void test_print_uint() {
     char out[24];
 
@@ -289,6 +366,67 @@ void test_print_summary() {
     assert_false(print_summary(data3, out3, sizeof(out3), 4, 4));
 }
 
+// amount printed with the C library, thousands separated and without trailing 0s
+static void print_amount_reference(uint64_t amount, char *out) {
+    char digits[21];
+    snprintf(digits, sizeof(digits), "%" PRIu64, amount / 10000000);
+    size_t count = strlen(digits);
+    size_t len = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0 && (count - i) % 3 == 0) {
+            out[len++] = ',';
+        }
+        out[len++] = digits[i];
+    }
+    uint32_t fraction = amount % 10000000;
+    if (fraction != 0) {
+        len += sprintf(out + len, ".%07u", fraction);
+        while (out[len - 1] == '0') {
+            len--;
+        }
+    }
+    out[len] = '\0';
+}
+
+void test_print_amount_random(void **state) {
+    (void) state;
+
+    char printed[AMOUNT_MAX_LENGTH + 3];
+    char expected[32];
+    char decimal[21];
+    const uint64_t edges[] = {0,
+                              1,
+                              9999999,
+                              10000000,
+                              10000001,
+                              9999999999999999999u,
+                              INT64_MAX,
+                              10000000000000000000u,
+                              UINT64_MAX};
+    srand(0x584c4d);
+    for (int i = 0; i < 100000 + (int) (sizeof(edges) / sizeof(edges[0])); i++) {
+        uint64_t amount;
+        if (i < (int) (sizeof(edges) / sizeof(edges[0]))) {
+            amount = edges[i];
+        } else {
+            // all magnitudes, from stroops to the largest amounts
+            amount = ((uint64_t) rand() << 40 ^ (uint64_t) rand() << 20 ^ rand()) >> (rand() % 64);
+        }
+        if (amount >= 10000000000000000000u) {
+            assert_false(print_amount(amount, NULL, NETWORK_TYPE_PUBLIC, printed, sizeof(printed)));
+        } else {
+            print_amount_reference(amount, expected);
+            assert_true(print_amount(amount, NULL, NETWORK_TYPE_PUBLIC, printed, sizeof(printed)));
+            assert_string_equal(printed, expected);
+        }
+        snprintf(decimal, sizeof(decimal), "%" PRIu64, amount);
+        assert_true(print_uint(amount, printed, sizeof(printed)));
+        assert_string_equal(printed, decimal);
+        assert_true(print_uint(amount, printed, strlen(decimal) + 1));
+        assert_false(print_uint(amount, printed, strlen(decimal)));
+    }
+}
+
 void test_print_amount_asset_native(void **state) {
     (void) state;
 
@@ -440,9 +578,64 @@ void test_print_account_flags(void **state) {
                         "AUTH_REQUIRED, AUTH_REVOCABLE, AUTH_IMMUTABLE, AUTH_CLAWBACK_ENABLED");
 }
 
+// bit by bit CRC16-XModem the table implementations must match
+static uint16_t crc16_reference(const uint8_t *input_str, int num_bytes) {
+    uint16_t crc = 0;
+    while (--num_bytes >= 0) {
+        crc = crc ^ (uint32_t) *input_str++ << 8;
+        for (int i = 0; i < 8; i++) {
+            crc = crc & 0x8000 ? crc << 1 ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static void test_crc16() {
+    uint8_t data[128];
+    srand(0x5354);
+    for (int round = 0; round < 1000; round++) {
+        for (size_t i = 0; i < sizeof(data); i++) {
+            data[i] = rand();
+        }
+        int length = rand() % (sizeof(data) + 1);
+        assert_int_equal(crc16(data, length), crc16_reference(data, length));
+    }
+    // every single byte value
+    for (int i = 0; i < 256; i++) {
+        data[0] = i;
+        assert_int_equal(crc16(data, 1), crc16_reference(data, 1));
+    }
+    // "123456789" check value of CRC16-XModem
+    assert_int_equal(crc16((const uint8_t *) "123456789", 9), 0x31C3);
+}
+
+static void test_base32_encode_blocks() {
+    uint8_t data[103];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = i * 167 + 13;
+    }
+    uint8_t expected[166];
+    uint8_t out[166];
+    for (int length = 0; length <= (int) sizeof(data); length++) {
+        int count = base32_encode(data, length, expected, sizeof(expected));
+        assert_int_equal(base32_encode_blocks(data, length, out, sizeof(out)), count);
+        assert_string_equal((char *) out, (char *) expected);
+        // exact size buffer, no room for the terminator
+        memset(out, 0, sizeof(out));
+        assert_int_equal(base32_encode_blocks(data, length, out, count), count);
+        assert_memory_equal(out, expected, count);
+        if (count > 0) {
+            assert_int_equal(base32_encode_blocks(data, length, out, count - 1), -1);
+        }
+    }
+}
+
 int main() {
     const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_crc16),
+        cmocka_unit_test(test_base32_encode_blocks),
         cmocka_unit_test(test_encode_ed25519_public_key),
+        cmocka_unit_test(test_encode_key_cached),
         cmocka_unit_test(test_encode_hash_x_key),
         cmocka_unit_test(test_encode_pre_auth_x_key),
         cmocka_unit_test(test_encode_muxed_account),
@@ -451,10 +644,12 @@ int main() {
         cmocka_unit_test(test_print_binary),
         cmocka_unit_test(test_print_claimable_balance_id),
         cmocka_unit_test(test_print_time),
+        cmocka_unit_test(test_print_time_every_day),
         cmocka_unit_test(test_print_uint),
         cmocka_unit_test(test_print_int),
         cmocka_unit_test(test_print_asset),
         cmocka_unit_test(test_print_summary),
+        cmocka_unit_test(test_print_amount_random),
         cmocka_unit_test(test_print_amount_asset_native),
         cmocka_unit_test(test_print_amount_asset_alphanum4),
         cmocka_unit_test(test_print_amount_asset_alphanum12),